@@ -4,6 +4,7 @@
 
 #include "LogicalDevice.h"
 #include "PhysicalDevice.h"
+#include "DeletionQueue.h"
 #include "AccelerationStructureNV.h"
 
 using namespace Lepton;
@@ -11,8 +12,8 @@ using namespace Lepton;
 /*************************************************************************
 **********************    TopLevelAccelStructNV    ***********************
 *************************************************************************/
-TopLevelAccelStructNV::UniqueHandle::UniqueHandle(DeviceLocalMemory deviceMemory, VkAccelerationStructureNV hAccelStruct,  uint64_t handle)
-	: m_DeviceMemory(deviceMemory), m_hAccelStruct(hAccelStruct), m_Handle(handle)
+TopLevelAccelStructNV::UniqueHandle::UniqueHandle(DeletionQueue * pDeletionQueue, DeviceLocalMemory deviceMemory, VkAccelerationStructureNV hAccelStruct, uint64_t handle)
+	: m_pDeletionQueue(pDeletionQueue), m_DeviceMemory(deviceMemory), m_hAccelStruct(hAccelStruct), m_Handle(handle)
 {
 
 }
@@ -81,7 +82,7 @@ Result TopLevelAccelStructNV::Create(const LogicalDevice * pLogicalDevice, uint3
 			MemoryInfo.pNext							= nullptr;
 			MemoryInfo.accelerationStructure			= hAccelerationStructure;
 			MemoryInfo.memory							= deviceMemory;
-			MemoryInfo.memoryOffset						= 0;
+			MemoryInfo.memoryOffset						= deviceMemory.Offset();
 			MemoryInfo.deviceIndexCount					= 0;
 			MemoryInfo.pDeviceIndices					= nullptr;
 
@@ -95,7 +96,7 @@ Result TopLevelAccelStructNV::Create(const LogicalDevice * pLogicalDevice, uint3
 
 				if (eResult == Result::eSuccess)
 				{
-					m_spUniqueHandle = std::make_shared<UniqueHandle>(deviceMemory, hAccelerationStructure, handle);
+					m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->GetDeletionQueue(), deviceMemory, hAccelerationStructure, handle);
 
 					return Result::eSuccess;
 				}
@@ -113,11 +114,16 @@ TopLevelAccelStructNV::UniqueHandle::~UniqueHandle() noexcept
 {
 	if (m_hAccelStruct != VK_NULL_HANDLE)
 	{
-		PFN_vkDestroyAccelerationStructureNV pfnDestroyAccelStruct = nullptr;
+		VkAccelerationStructureNV hAccelStruct = m_hAccelStruct;
 
-		pfnDestroyAccelStruct = (PFN_vkDestroyAccelerationStructureNV)vkGetDeviceProcAddr(m_DeviceMemory.GetDeviceHandle(), "vkDestroyAccelerationStructureNV");
+		m_pDeletionQueue->Enqueue([hAccelStruct, deviceMemory = m_DeviceMemory]()
+		{
+			PFN_vkDestroyAccelerationStructureNV pfnDestroyAccelStruct = nullptr;
+
+			pfnDestroyAccelStruct = (PFN_vkDestroyAccelerationStructureNV)vkGetDeviceProcAddr(deviceMemory.GetDeviceHandle(), "vkDestroyAccelerationStructureNV");
 
-		pfnDestroyAccelStruct(m_DeviceMemory.GetDeviceHandle(), m_hAccelStruct, nullptr);
+			pfnDestroyAccelStruct(deviceMemory.GetDeviceHandle(), hAccelStruct, nullptr);
+		});
 	}
 }
 
@@ -125,8 +131,8 @@ TopLevelAccelStructNV::UniqueHandle::~UniqueHandle() noexcept
 /*************************************************************************
 *********************    BottomLevelAccelStructNV    *********************
 *************************************************************************/
-BottomLevelAccelStructNV::UniqueHandle::UniqueHandle(DeviceLocalMemory deviceMemory, VkAccelerationStructureNV hAccelStruct, uint64_t handle)
-	: m_DeviceMemory(deviceMemory), m_hAccelStruct(hAccelStruct), m_Handle(handle)
+BottomLevelAccelStructNV::UniqueHandle::UniqueHandle(DeletionQueue * pDeletionQueue, DeviceLocalMemory deviceMemory, VkAccelerationStructureNV hAccelStruct, uint64_t handle)
+	: m_pDeletionQueue(pDeletionQueue), m_DeviceMemory(deviceMemory), m_hAccelStruct(hAccelStruct), m_Handle(handle)
 {
 
 }
@@ -195,7 +201,7 @@ Result BottomLevelAccelStructNV::Create(const LogicalDevice * pLogicalDevice, vk
 			MemoryInfo.pNext							= nullptr;
 			MemoryInfo.accelerationStructure			= hAccelerationStructure;
 			MemoryInfo.memory							= deviceMemory;
-			MemoryInfo.memoryOffset						= 0;
+			MemoryInfo.memoryOffset						= deviceMemory.Offset();
 			MemoryInfo.deviceIndexCount					= 0;
 			MemoryInfo.pDeviceIndices					= nullptr;
 
@@ -209,7 +215,7 @@ Result BottomLevelAccelStructNV::Create(const LogicalDevice * pLogicalDevice, vk
 
 				if (eResult == Result::eSuccess)
 				{
-					m_spUniqueHandle = std::make_shared<UniqueHandle>(deviceMemory, hAccelerationStructure, handle);
+					m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->GetDeletionQueue(), deviceMemory, hAccelerationStructure, handle);
 
 					return Result::eSuccess;
 				}
@@ -227,10 +233,15 @@ BottomLevelAccelStructNV::UniqueHandle::~UniqueHandle() noexcept
 {
 	if (m_hAccelStruct != VK_NULL_HANDLE)
 	{
-		PFN_vkDestroyAccelerationStructureNV pfnDestroyAccelStruct = nullptr;
+		VkAccelerationStructureNV hAccelStruct = m_hAccelStruct;
+
+		m_pDeletionQueue->Enqueue([hAccelStruct, deviceMemory = m_DeviceMemory]()
+		{
+			PFN_vkDestroyAccelerationStructureNV pfnDestroyAccelStruct = nullptr;
 
-		pfnDestroyAccelStruct = (PFN_vkDestroyAccelerationStructureNV)vkGetDeviceProcAddr(m_DeviceMemory.GetDeviceHandle(), "vkDestroyAccelerationStructureNV");
+			pfnDestroyAccelStruct = (PFN_vkDestroyAccelerationStructureNV)vkGetDeviceProcAddr(deviceMemory.GetDeviceHandle(), "vkDestroyAccelerationStructureNV");
 
-		pfnDestroyAccelStruct(m_DeviceMemory.GetDeviceHandle(), m_hAccelStruct, nullptr);
+			pfnDestroyAccelStruct(deviceMemory.GetDeviceHandle(), hAccelStruct, nullptr);
+		});
 	}
 }
\ No newline at end of file
@@ -131,14 +131,15 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(DeviceLocalMemory, VkAccelerationStructureNV, uint64_t);
+			UniqueHandle(DeletionQueue*, DeviceLocalMemory, VkAccelerationStructureNV, uint64_t);
 
-			//!	@brief	Where resource will be released.
+			//!	@brief	Where resource will be queued for release.
 			~UniqueHandle() noexcept;
 
 		public:
 
 			const uint64_t						m_Handle;
+			DeletionQueue * const				m_pDeletionQueue;
 			const DeviceLocalMemory				m_DeviceMemory;
 			const VkAccelerationStructureNV		m_hAccelStruct;
 		};
@@ -186,14 +187,15 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(DeviceLocalMemory, VkAccelerationStructureNV, uint64_t);
+			UniqueHandle(DeletionQueue*, DeviceLocalMemory, VkAccelerationStructureNV, uint64_t);
 
-			//!	@brief	Where resource will be released.
+			//!	@brief	Where resource will be queued for release.
 			~UniqueHandle() noexcept;
 
 		public:
 
 			const uint64_t						m_Handle;
+			DeletionQueue * const				m_pDeletionQueue;
 			const DeviceLocalMemory				m_DeviceMemory;
 			const VkAccelerationStructureNV		m_hAccelStruct;
 		};
@@ -0,0 +1,233 @@
+/*************************************************************************
+**********************    Lepton_BindlessTable    ************************
+*************************************************************************/
+
+#include "BindlessTable.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+**************************    BindlessTable    ***************************
+*************************************************************************/
+BindlessTable::BindlessTable() : m_hDevice(VK_NULL_HANDLE), m_hDescriptorPool(VK_NULL_HANDLE), m_hDescriptorSet(VK_NULL_HANDLE)
+{
+
+}
+
+
+Result BindlessTable::Create(VkDevice hDevice, uint32_t maxBuffers, uint32_t maxSamplers, uint32_t maxImages)
+{
+	if (hDevice == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+	if (maxImages == 0)					return Result::eErrorInitializationFailed;
+
+	this->Destroy();
+
+	const vk::ShaderStageFlags eStages = vk::ShaderStageFlagBits::eAll;
+
+	std::vector<vk::DescriptorSetLayoutBinding> LayoutBindings =
+	{
+		vk::DescriptorSetLayoutBinding(BufferBinding, vk::DescriptorType::eStorageBuffer, maxBuffers, eStages),
+		vk::DescriptorSetLayoutBinding(SamplerBinding, vk::DescriptorType::eSampler, maxSamplers, eStages),
+		vk::DescriptorSetLayoutBinding(ImageBinding, vk::DescriptorType::eSampledImage, maxImages, eStages),
+	};
+
+	//	Unused slots may stay unwritten, and slots can be written while the set is bound.
+	const VkDescriptorBindingFlagsEXT eBindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+
+	const std::vector<VkDescriptorBindingFlagsEXT> BindingFlags = { eBindingFlags, eBindingFlags, eBindingFlags | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT };
+
+	Result eResult = m_DescriptorSetLayout.Create(hDevice, LayoutBindings, vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPoolEXT, BindingFlags);
+
+	if (eResult != Result::eSuccess)		return eResult;
+
+	std::vector<VkDescriptorPoolSize> PoolSizes;
+
+	if (maxBuffers != 0)		PoolSizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, maxBuffers });
+	if (maxSamplers != 0)		PoolSizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLER, maxSamplers });
+
+	PoolSizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxImages });
+
+	VkDescriptorPoolCreateInfo		CreateInfo = {};
+	CreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	CreateInfo.pNext				= nullptr;
+	CreateInfo.flags				= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+	CreateInfo.maxSets				= 1;
+	CreateInfo.poolSizeCount		= static_cast<uint32_t>(PoolSizes.size());
+	CreateInfo.pPoolSizes			= PoolSizes.data();
+
+	eResult = LAVA_RESULT_CAST(vkCreateDescriptorPool(hDevice, &CreateInfo, nullptr, &m_hDescriptorPool));
+
+	if (eResult != Result::eSuccess)
+	{
+		m_DescriptorSetLayout.Destroy();
+
+		return eResult;
+	}
+
+	m_hDevice = hDevice;
+
+	VkDescriptorSetLayout hDescriptorSetLayout = m_DescriptorSetLayout;
+
+	VkDescriptorSetVariableDescriptorCountAllocateInfoEXT		VariableCountInfo = {};
+	VariableCountInfo.sType										= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+	VariableCountInfo.pNext										= nullptr;
+	VariableCountInfo.descriptorSetCount						= 1;
+	VariableCountInfo.pDescriptorCounts							= &maxImages;
+
+	VkDescriptorSetAllocateInfo			AllocateInfo = {};
+	AllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	AllocateInfo.pNext					= &VariableCountInfo;
+	AllocateInfo.descriptorPool			= m_hDescriptorPool;
+	AllocateInfo.descriptorSetCount		= 1;
+	AllocateInfo.pSetLayouts			= &hDescriptorSetLayout;
+
+	eResult = LAVA_RESULT_CAST(vkAllocateDescriptorSets(hDevice, &AllocateInfo, &m_hDescriptorSet));
+
+	if (eResult != Result::eSuccess)
+	{
+		this->Destroy();
+
+		return eResult;
+	}
+
+	m_Slots[BufferBinding].capacity = maxBuffers;
+
+	m_Slots[SamplerBinding].capacity = maxSamplers;
+
+	m_Slots[ImageBinding].capacity = maxImages;
+
+	for (auto & slots : m_Slots)
+	{
+		slots.isLive.assign(slots.capacity, false);
+	}
+
+	return Result::eSuccess;
+}
+
+
+uint32_t BindlessTable::AcquireIndex(uint32_t binding)
+{
+	Slots & slots = m_Slots[binding];
+
+	uint32_t index = LAVA_INVALID_INDEX;
+
+	if (!slots.freeIndices.empty())
+	{
+		index = slots.freeIndices.back();
+
+		slots.freeIndices.pop_back();
+	}
+	else if (slots.nextIndex < slots.capacity)
+	{
+		index = slots.nextIndex++;
+	}
+
+	if (index != LAVA_INVALID_INDEX)
+	{
+		slots.isLive[index] = true;
+	}
+
+	return index;
+}
+
+
+uint32_t BindlessTable::RegisterBuffer(VkBuffer hBuffer, VkDeviceSize offset, VkDeviceSize range)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	uint32_t index = this->AcquireIndex(BufferBinding);
+
+	if (index != LAVA_INVALID_INDEX)
+	{
+		m_PendingWrites.WriteBuffer(m_hDescriptorSet, BufferBinding, index, vk::DescriptorType::eStorageBuffer, hBuffer, offset, range);
+	}
+
+	return index;
+}
+
+
+uint32_t BindlessTable::RegisterSampler(VkSampler hSampler)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	uint32_t index = this->AcquireIndex(SamplerBinding);
+
+	if (index != LAVA_INVALID_INDEX)
+	{
+		m_PendingWrites.WriteImage(m_hDescriptorSet, SamplerBinding, index, vk::DescriptorType::eSampler, hSampler, VK_NULL_HANDLE, vk::ImageLayout::eUndefined);
+	}
+
+	return index;
+}
+
+
+uint32_t BindlessTable::RegisterImage(VkImageView hImageView, vk::ImageLayout eImageLayout)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	uint32_t index = this->AcquireIndex(ImageBinding);
+
+	if (index != LAVA_INVALID_INDEX)
+	{
+		m_PendingWrites.WriteImage(m_hDescriptorSet, ImageBinding, index, vk::DescriptorType::eSampledImage, VK_NULL_HANDLE, hImageView, eImageLayout);
+	}
+
+	return index;
+}
+
+
+void BindlessTable::Release(uint32_t binding, uint32_t index)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	Slots & slots = m_Slots[binding];
+
+	//	A second release would hand the index out twice, so only live indices are taken back.
+	//	Partially bound: the stale descriptor is harmless as long as no shader indexes it.
+	if ((index < slots.nextIndex) && slots.isLive[index])
+	{
+		slots.isLive[index] = false;
+
+		slots.freeIndices.push_back(index);
+	}
+}
+
+
+void BindlessTable::Flush()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_PendingWrites.Flush(m_hDevice);
+}
+
+
+void BindlessTable::Destroy()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	if (m_hDescriptorPool != VK_NULL_HANDLE)
+	{
+		vkDestroyDescriptorPool(m_hDevice, m_hDescriptorPool, nullptr);
+	}
+
+	m_DescriptorSetLayout.Destroy();
+
+	m_PendingWrites.Clear();
+
+	for (auto & slots : m_Slots)
+	{
+		slots = Slots();
+	}
+
+	m_hDescriptorPool = VK_NULL_HANDLE;
+
+	m_hDescriptorSet = VK_NULL_HANDLE;
+
+	m_hDevice = VK_NULL_HANDLE;
+}
+
+
+BindlessTable::~BindlessTable()
+{
+	this->Destroy();
+}
\ No newline at end of file
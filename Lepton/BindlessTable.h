@@ -0,0 +1,111 @@
+/*************************************************************************
+**********************    Lepton_BindlessTable    ************************
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include "DescriptorWriter.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	************************    BindlessTable    *************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Global descriptor set of storage buffers, samplers and sampled images, addressed by 32-bit indices.
+	 *	@note	Bind the set once per frame and pass indices through push constants. Requires VK_EXT_descriptor_indexing
+	 *			with update-after-bind, partially bound and variable descriptor count features enabled on the device.
+	 *			Registration is thread safe, new descriptors become visible with the next Flush().
+	 */
+	class BindlessTable
+	{
+		LAVA_NONCOPYABLE(BindlessTable)
+
+	public:
+
+		static constexpr uint32_t		BufferBinding		= 0;
+		static constexpr uint32_t		SamplerBinding		= 1;
+		static constexpr uint32_t		ImageBinding		= 2;		//!	Last binding, its count is variable.
+
+	public:
+
+		//!	@brief	Create bindless table object.
+		BindlessTable();
+
+		//!	@brief	Destroy bindless table object.
+		~BindlessTable();
+
+	public:
+
+		//!	@brief	Create the layout, pool and the single set with room for the given number of each resource.
+		Result Create(VkDevice hDevice, uint32_t maxBuffers, uint32_t maxSamplers, uint32_t maxImages);
+
+		//!	@brief	Return the set layout, add it to pipeline layouts using the table.
+		const DescriptorSetLayout & GetLayout() const { return m_DescriptorSetLayout; }
+
+		//!	@brief	Return the descriptor set.
+		VkDescriptorSet Handle() const { return m_hDescriptorSet; }
+
+		//!	@brief	Register a storage buffer range, return its index (LAVA_INVALID_INDEX if the table is full).
+		uint32_t RegisterBuffer(VkBuffer hBuffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+		//!	@brief	Register a sampler, return its index (LAVA_INVALID_INDEX if the table is full).
+		uint32_t RegisterSampler(VkSampler hSampler);
+
+		//!	@brief	Register a sampled image view, return its index (LAVA_INVALID_INDEX if the table is full).
+		uint32_t RegisterImage(VkImageView hImageView, vk::ImageLayout eImageLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
+		//!	@brief	Return a buffer index for reuse, only once no pending work references it (e.g. from DeletionQueue).
+		void ReleaseBuffer(uint32_t index) { this->Release(BufferBinding, index); }
+
+		//!	@brief	Return a sampler index for reuse, only once no pending work references it (e.g. from DeletionQueue).
+		void ReleaseSampler(uint32_t index) { this->Release(SamplerBinding, index); }
+
+		//!	@brief	Return an image index for reuse, only once no pending work references it (e.g. from DeletionQueue).
+		void ReleaseImage(uint32_t index) { this->Release(ImageBinding, index); }
+
+		//!	@brief	Write all registrations since the last flush with one update (allowed while the set is bound).
+		void Flush();
+
+		//!	@brief	Destroy the set, pool and layout.
+		void Destroy();
+
+	private:
+
+		//!	@brief	Take a free index of the binding (m_Mutex must be held).
+		uint32_t AcquireIndex(uint32_t binding);
+
+		//!	@brief	Return an index of the binding to its free list (indices that are not registered are ignored).
+		void Release(uint32_t binding, uint32_t index);
+
+	private:
+
+		/**
+		 *	@brief	Index allocator of one binding.
+		 */
+		struct Slots
+		{
+			uint32_t						capacity		= 0;
+			uint32_t						nextIndex		= 0;
+			std::vector<uint32_t>			freeIndices;
+			std::vector<bool>				isLive;			//!	Per index, guards against releasing twice.
+		};
+
+	private:
+
+		std::mutex							m_Mutex;
+
+		VkDevice							m_hDevice;
+
+		VkDescriptorPool					m_hDescriptorPool;
+
+		VkDescriptorSet						m_hDescriptorSet;
+
+		DescriptorSetLayout					m_DescriptorSetLayout;
+
+		DescriptorWriter					m_PendingWrites;
+
+		Slots								m_Slots[3];
+	};
+}
\ No newline at end of file
@@ -2,8 +2,11 @@
 **************************    Lepton_Buffers    **************************
 *************************************************************************/
 
+#include <numeric>
+#include <algorithm>
 #include "Buffers.h"
 #include "LogicalDevice.h"
+#include "DeletionQueue.h"
 #include "PhysicalDevice.h"
 
 using namespace Lepton;
@@ -11,19 +14,19 @@ using namespace Lepton;
 /*************************************************************************
 ************************    HostVisibleBuffer    *************************
 *************************************************************************/
-HostVisibleBuffer::HostVisibleBuffer() : m_hBuffer(VK_NULL_HANDLE), m_Bytes(0)
+HostVisibleBuffer::HostVisibleBuffer() : m_hBuffer(VK_NULL_HANDLE), m_pDeletionQueue(nullptr), m_Bytes(0), m_pMappedData(nullptr), m_NonCoherentAtomSize(1)
 {
 
 }
 
 
-HostVisibleBuffer::HostVisibleBuffer(const LogicalDevice * pLogicalDevice, VkDeviceSize size) : HostVisibleBuffer()
+HostVisibleBuffer::HostVisibleBuffer(const LogicalDevice * pLogicalDevice, VkDeviceSize size, bool isPersistentlyMapped, MemoryUsage eUsage) : HostVisibleBuffer()
 {
-	this->Create(pLogicalDevice, size);
+	this->Create(pLogicalDevice, size, isPersistentlyMapped, eUsage);
 }
 
 
-Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size)
+Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size, bool isPersistentlyMapped, MemoryUsage eUsage)
 {
 	if (size == 0)							return Result::eErrorOutOfDeviceMemory;
 	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
@@ -33,7 +36,8 @@ Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 	CreateInfo.pNext						= nullptr;
 	CreateInfo.flags						= 0;
 	CreateInfo.size							= size;
-	CreateInfo.usage						= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+	CreateInfo.usage						= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+											  VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 	CreateInfo.sharingMode					= VK_SHARING_MODE_EXCLUSIVE;
 	CreateInfo.queueFamilyIndexCount		= 0;
 	CreateInfo.pQueueFamilyIndices			= nullptr;
@@ -44,11 +48,13 @@ Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 
 	if (eResult == Result::eSuccess)
 	{
+		DeviceMemory deviceMemory;
+
 		VkMemoryRequirements Requirements = {};
 
 		vkGetBufferMemoryRequirements(pLogicalDevice->Handle(), hNewBuffer, &Requirements);
 
-		eResult = m_Memory.Allocate(pLogicalDevice, Requirements, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+		eResult = deviceMemory.Allocate(pLogicalDevice, Requirements, eUsage);
 
 		if (eResult != Result::eSuccess)
 		{
@@ -56,16 +62,25 @@ Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 		}
 		else
 		{
-			if (m_hBuffer != VK_NULL_HANDLE)
-			{
-				vkDestroyBuffer(m_Memory.GetDeviceHandle(), m_hBuffer, nullptr);
-			}
+			this->Destroy();
+
+			vkBindBufferMemory(pLogicalDevice->Handle(), hNewBuffer, deviceMemory, 0);
 
-			vkBindBufferMemory(pLogicalDevice->Handle(), hNewBuffer, m_Memory, 0);
+			m_pDeletionQueue = pLogicalDevice->GetDeletionQueue();
+
+			m_Memory = deviceMemory;
 
 			m_hBuffer = hNewBuffer;
 
 			m_Bytes = size;
+
+			m_NonCoherentAtomSize = pLogicalDevice->GetPhysicalDevice()->GetProperties().limits.nonCoherentAtomSize;
+
+			//	Flush and invalidate require the memory to be mapped, so non-coherent buffers are always persistently mapped.
+			if (isPersistentlyMapped || !this->IsCoherent())
+			{
+				eResult = m_Memory.Map(&m_pMappedData, 0, VK_WHOLE_SIZE);
+			}
 		}
 	}
 
@@ -75,6 +90,15 @@ Result HostVisibleBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 
 Result HostVisibleBuffer::Write(const void * pHostData, VkDeviceSize offset, VkDeviceSize size)
 {
+	if (m_pMappedData != nullptr)
+	{
+		std::memcpy(static_cast<uint8_t*>(m_pMappedData) + offset, pHostData, static_cast<size_t>(size));
+
+		this->MarkDirty(offset, size);
+
+		return Result::eSuccess;
+	}
+
 	void * pBufferData = nullptr;
 
 	Result eResult = m_Memory.Map(&pBufferData, offset, size);
@@ -92,6 +116,13 @@ Result HostVisibleBuffer::Write(const void * pHostData, VkDeviceSize offset, VkD
 
 Result HostVisibleBuffer::Read(void * pHostData, VkDeviceSize offset, VkDeviceSize size)
 {
+	if (m_pMappedData != nullptr)
+	{
+		std::memcpy(pHostData, static_cast<const uint8_t*>(m_pMappedData) + offset, static_cast<size_t>(size));
+
+		return Result::eSuccess;
+	}
+
 	void * pBufferData = nullptr;
 
 	Result eResult = m_Memory.Map(&pBufferData, offset, size);
@@ -109,6 +140,15 @@ Result HostVisibleBuffer::Read(void * pHostData, VkDeviceSize offset, VkDeviceSi
 
 Result HostVisibleBuffer::SetZero(VkDeviceSize offset, VkDeviceSize size)
 {
+	if (m_pMappedData != nullptr)
+	{
+		std::memset(static_cast<uint8_t*>(m_pMappedData) + offset, 0, static_cast<size_t>(size));
+
+		this->MarkDirty(offset, size);
+
+		return Result::eSuccess;
+	}
+
 	void * pBufferData = nullptr;
 
 	Result eResult = m_Memory.Map(&pBufferData, offset, size);
@@ -124,14 +164,146 @@ Result HostVisibleBuffer::SetZero(VkDeviceSize offset, VkDeviceSize size)
 }
 
 
+void HostVisibleBuffer::MarkDirty(VkDeviceSize offset, VkDeviceSize size)
+{
+	if (!this->IsCoherent())
+	{
+		m_DirtyRanges.emplace_back(offset, size);
+	}
+}
+
+
+VkMappedMemoryRange HostVisibleBuffer::GetAlignedRange(VkDeviceSize offset, VkDeviceSize size) const
+{
+	VkDeviceSize end = (size == VK_WHOLE_SIZE) ? m_Memory.Size() : std::min(offset + size, m_Memory.Size());
+
+	offset = offset / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+
+	//	Size must be a multiple of the atom size, unless the range reaches the end of the allocation.
+	end = std::min((end + m_NonCoherentAtomSize - 1) / m_NonCoherentAtomSize * m_NonCoherentAtomSize, m_Memory.Size());
+
+	VkMappedMemoryRange		MemoryRange = {};
+	MemoryRange.sType		= VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	MemoryRange.pNext		= nullptr;
+	MemoryRange.memory		= m_Memory;
+	MemoryRange.offset		= offset;
+	MemoryRange.size		= end - offset;
+
+	return MemoryRange;
+}
+
+
+void HostVisibleBuffer::CollectDirtyRanges(std::vector<VkMappedMemoryRange> & MemoryRanges)
+{
+	if (m_DirtyRanges.empty())		return;
+
+	std::sort(m_DirtyRanges.begin(), m_DirtyRanges.end());
+
+	VkMappedMemoryRange MemoryRange = this->GetAlignedRange(m_DirtyRanges[0].first, m_DirtyRanges[0].second);
+
+	for (size_t i = 1; i < m_DirtyRanges.size(); i++)
+	{
+		VkMappedMemoryRange NextRange = this->GetAlignedRange(m_DirtyRanges[i].first, m_DirtyRanges[i].second);
+
+		if (NextRange.offset <= MemoryRange.offset + MemoryRange.size)
+		{
+			MemoryRange.size = std::max(MemoryRange.offset + MemoryRange.size, NextRange.offset + NextRange.size) - MemoryRange.offset;
+		}
+		else
+		{
+			MemoryRanges.push_back(MemoryRange);
+
+			MemoryRange = NextRange;
+		}
+	}
+
+	MemoryRanges.push_back(MemoryRange);
+
+	m_DirtyRanges.clear();
+}
+
+
+Result HostVisibleBuffer::Flush()
+{
+	std::vector<VkMappedMemoryRange> MemoryRanges;
+
+	this->CollectDirtyRanges(MemoryRanges);
+
+	if (MemoryRanges.empty())		return Result::eSuccess;
+
+	return LAVA_RESULT_CAST(vkFlushMappedMemoryRanges(m_Memory.GetDeviceHandle(), static_cast<uint32_t>(MemoryRanges.size()), MemoryRanges.data()));
+}
+
+
+Result HostVisibleBuffer::Invalidate(VkDeviceSize offset, VkDeviceSize size)
+{
+	if (this->IsCoherent() || (m_pMappedData == nullptr))		return Result::eSuccess;
+
+	VkMappedMemoryRange MemoryRange = this->GetAlignedRange(offset, size);
+
+	return LAVA_RESULT_CAST(vkInvalidateMappedMemoryRanges(m_Memory.GetDeviceHandle(), 1, &MemoryRange));
+}
+
+
+Result HostVisibleBuffer::Flush(vk::ArrayProxy<HostVisibleBuffer*> pBuffers)
+{
+	VkDevice hDevice = VK_NULL_HANDLE;
+
+	std::vector<VkMappedMemoryRange> MemoryRanges;
+
+	for (auto pBuffer : pBuffers)
+	{
+		if (pBuffer->m_DirtyRanges.empty())		continue;
+
+		hDevice = pBuffer->m_Memory.GetDeviceHandle();
+
+		pBuffer->CollectDirtyRanges(MemoryRanges);
+	}
+
+	if (MemoryRanges.empty())		return Result::eSuccess;
+
+	return LAVA_RESULT_CAST(vkFlushMappedMemoryRanges(hDevice, static_cast<uint32_t>(MemoryRanges.size()), MemoryRanges.data()));
+}
+
+
+Result HostVisibleBuffer::Invalidate(vk::ArrayProxy<HostVisibleBuffer*> pBuffers)
+{
+	VkDevice hDevice = VK_NULL_HANDLE;
+
+	std::vector<VkMappedMemoryRange> MemoryRanges;
+
+	for (auto pBuffer : pBuffers)
+	{
+		if (pBuffer->IsCoherent() || (pBuffer->m_pMappedData == nullptr))		continue;
+
+		hDevice = pBuffer->m_Memory.GetDeviceHandle();
+
+		MemoryRanges.push_back(pBuffer->GetAlignedRange(0, VK_WHOLE_SIZE));
+	}
+
+	if (MemoryRanges.empty())		return Result::eSuccess;
+
+	return LAVA_RESULT_CAST(vkInvalidateMappedMemoryRanges(hDevice, static_cast<uint32_t>(MemoryRanges.size()), MemoryRanges.data()));
+}
+
+
 void HostVisibleBuffer::Destroy()
 {
 	if (m_hBuffer != VK_NULL_HANDLE)
 	{
-		vkDestroyBuffer(m_Memory.GetDeviceHandle(), m_hBuffer, nullptr);
+		if (m_pMappedData != nullptr)
+		{
+			m_Memory.Unmap();
+
+			m_pMappedData = nullptr;
+		}
+
+		m_pDeletionQueue->Enqueue([hBuffer = m_hBuffer, deviceMemory = m_Memory]() { vkDestroyBuffer(deviceMemory.GetDeviceHandle(), hBuffer, nullptr); });
 
 		m_hBuffer = VK_NULL_HANDLE;
 
+		m_DirtyRanges.clear();
+
 		m_Memory.Free();
 
 		m_Bytes = 0;
@@ -148,7 +320,7 @@ HostVisibleBuffer::~HostVisibleBuffer()
 /*************************************************************************
 ************************    DeviceLocalBuffer    *************************
 *************************************************************************/
-DeviceLocalBuffer::DeviceLocalBuffer() : m_hBuffer(VK_NULL_HANDLE)
+DeviceLocalBuffer::DeviceLocalBuffer() : m_hBuffer(VK_NULL_HANDLE), m_pDeletionQueue(nullptr)
 {
 
 }
@@ -175,11 +347,13 @@ Result DeviceLocalBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 
 	if (eResult == Result::eSuccess)
 	{
+		DeviceLocalMemory		deviceMemory;
+
 		VkMemoryRequirements	Requirements = {};
 
 		vkGetBufferMemoryRequirements(pLogicalDevice->Handle(), hNewBuffer, &Requirements);
 
-		eResult = m_DeviceMemory.Allocate(pLogicalDevice, Requirements);
+		eResult = deviceMemory.Allocate(pLogicalDevice, Requirements);
 
 		if (eResult != Result::eSuccess)
 		{
@@ -187,12 +361,13 @@ Result DeviceLocalBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceS
 		}
 		else
 		{
-			if (m_hBuffer != VK_NULL_HANDLE)
-			{
-				vkDestroyBuffer(m_DeviceMemory.GetDeviceHandle(), m_hBuffer, nullptr);
-			}
+			this->Destroy();
+
+			vkBindBufferMemory(pLogicalDevice->Handle(), hNewBuffer, deviceMemory, deviceMemory.Offset());
+
+			m_pDeletionQueue = pLogicalDevice->GetDeletionQueue();
 
-			vkBindBufferMemory(pLogicalDevice->Handle(), hNewBuffer, m_DeviceMemory, 0);
+			m_DeviceMemory = deviceMemory;
 
 			m_hBuffer = hNewBuffer;
 		}
@@ -206,7 +381,7 @@ void DeviceLocalBuffer::Destroy()
 {
 	if (m_hBuffer != VK_NULL_HANDLE)
 	{
-		vkDestroyBuffer(m_DeviceMemory.GetDeviceHandle(), m_hBuffer, nullptr);
+		m_pDeletionQueue->Enqueue([hBuffer = m_hBuffer, deviceMemory = m_DeviceMemory]() { vkDestroyBuffer(deviceMemory.GetDeviceHandle(), hBuffer, nullptr); });
 
 		m_hBuffer = VK_NULL_HANDLE;
 
@@ -216,6 +391,227 @@ void DeviceLocalBuffer::Destroy()
 
 
 DeviceLocalBuffer::~DeviceLocalBuffer()
+{
+	this->Destroy();
+}
+
+
+/*************************************************************************
+***************************    RingBuffer    *****************************
+*************************************************************************/
+RingBuffer::RingBuffer() : m_Alignment(1), m_Head(0), m_Tail(0), m_FrameBegin(0)
+{
+
+}
+
+
+Result RingBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size, MemoryUsage eUsage)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+
+	Result eResult = m_Buffer.Create(pLogicalDevice, size, true, eUsage);
+
+	if (eResult == Result::eSuccess)
+	{
+		m_Alignment = std::max<VkDeviceSize>(pLogicalDevice->GetPhysicalDevice()->GetProperties().limits.minUniformBufferOffsetAlignment, 1);
+
+		m_Head = m_Tail = m_FrameBegin = 0;
+
+		m_InFlightFrames.clear();
+	}
+
+	return eResult;
+}
+
+
+RingBuffer::Allocation RingBuffer::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+	Allocation allocation;
+
+	const VkDeviceSize capacity = m_Buffer.Bytes();
+
+	if ((size == 0) || (size > capacity))		return allocation;
+
+	//	Texel block sizes need not be powers of two (e.g. 12 bytes), so combine them with the ring alignment.
+	alignment = std::lcm(std::max<VkDeviceSize>(alignment, 1), m_Alignment);
+
+	VkDeviceSize lapBegin = m_Head - m_Head % capacity;
+
+	VkDeviceSize offset = (m_Head - lapBegin + alignment - 1) / alignment * alignment;
+
+	//	Never split a range across the end of the ring, skip to the next lap instead.
+	if (offset + size > capacity)
+	{
+		lapBegin += capacity;
+
+		offset = 0;
+	}
+
+	if (lapBegin + offset + size - m_Tail > capacity)		return allocation;
+
+	m_Head = lapBegin + offset + size;
+
+	allocation.hBuffer		= m_Buffer;
+	allocation.offset		= offset;
+	allocation.size			= size;
+	allocation.pData		= static_cast<uint8_t*>(m_Buffer.MappedData()) + offset;
+
+	return allocation;
+}
+
+
+RingBuffer::Allocation RingBuffer::Upload(const void * pHostData, VkDeviceSize size, VkDeviceSize alignment)
+{
+	Allocation allocation = this->Allocate(size, alignment);
+
+	if (allocation)
+	{
+		std::memcpy(allocation.pData, pHostData, static_cast<size_t>(size));
+	}
+
+	return allocation;
+}
+
+
+Result RingBuffer::Flush()
+{
+	const VkDeviceSize capacity = m_Buffer.Bytes();
+
+	if (m_Head == m_FrameBegin)		return Result::eSuccess;
+
+	if (!m_Buffer.IsCoherent())
+	{
+		const VkDeviceSize begin = m_FrameBegin % capacity;
+
+		if (m_Head - m_FrameBegin >= capacity)
+		{
+			m_Buffer.MarkDirty(0, capacity);
+		}
+		else if (begin + (m_Head - m_FrameBegin) <= capacity)
+		{
+			m_Buffer.MarkDirty(begin, m_Head - m_FrameBegin);
+		}
+		else
+		{
+			m_Buffer.MarkDirty(begin, capacity - begin);
+
+			m_Buffer.MarkDirty(0, m_Head % capacity);
+		}
+	}
+
+	return m_Buffer.Flush();
+}
+
+
+void RingBuffer::CloseFrame(VkFence hFence)
+{
+	if (m_Head == m_FrameBegin)		return;
+
+	m_InFlightFrames.push_back({ hFence, m_Head });
+
+	m_FrameBegin = m_Head;
+}
+
+
+Result RingBuffer::EndFrame(VkFence hFence)
+{
+	Result eResult = this->Flush();
+
+	if (eResult == Result::eSuccess)
+	{
+		this->CloseFrame(hFence);
+	}
+
+	return eResult;
+}
+
+
+void RingBuffer::Retire()
+{
+	while (!m_InFlightFrames.empty())
+	{
+		const InFlightFrame & frame = m_InFlightFrames.front();
+
+		if (vkGetFenceStatus(m_Buffer.GetDeviceHandle(), frame.hFence) != VK_SUCCESS)		break;
+
+		m_Tail = frame.end;
+
+		m_InFlightFrames.pop_front();
+	}
+}
+
+
+void RingBuffer::Destroy()
+{
+	m_Buffer.Destroy();
+
+	m_InFlightFrames.clear();
+
+	m_Head = m_Tail = m_FrameBegin = 0;
+}
+
+
+RingBuffer::~RingBuffer()
+{
+	this->Destroy();
+}
+
+/*************************************************************************
+*************************    UniformStreamer    **************************
+*************************************************************************/
+UniformStreamer::UniformStreamer() : m_ObjectRange(0)
+{
+
+}
+
+
+Result UniformStreamer::Create(const LogicalDevice * pLogicalDevice, VkDeviceSize objectRange, VkDeviceSize size)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (objectRange == 0)					return Result::eErrorInitializationFailed;
+	if (size < objectRange)					return Result::eErrorInitializationFailed;
+
+	//	Dynamic offsets are 32-bit.
+	if (size > UINT32_MAX)					return Result::eErrorInitializationFailed;
+
+	if (objectRange > pLogicalDevice->GetPhysicalDevice()->GetProperties().limits.maxUniformBufferRange)		return Result::eErrorInitializationFailed;
+
+	//	Uniforms are read in place by the device, device-local host-visible memory keeps them off the PCIe bus.
+	Result eResult = m_Ring.Create(pLogicalDevice, size, MemoryUsage::eCpuToGpu);
+
+	if (eResult == Result::eSuccess)
+	{
+		m_ObjectRange = objectRange;
+	}
+
+	return eResult;
+}
+
+
+uint32_t UniformStreamer::Push(const void * pHostData, VkDeviceSize size)
+{
+	if (size > m_ObjectRange)				return LAVA_INVALID_INDEX;
+
+	//	Always reserve the whole descriptor range, so offset + range stays inside the buffer.
+	RingBuffer::Allocation allocation = m_Ring.Allocate(m_ObjectRange);
+
+	if (!allocation)						return LAVA_INVALID_INDEX;
+
+	std::memcpy(allocation.pData, pHostData, static_cast<size_t>(size));
+
+	return static_cast<uint32_t>(allocation.offset);
+}
+
+
+void UniformStreamer::Destroy()
+{
+	m_Ring.Destroy();
+
+	m_ObjectRange = 0;
+}
+
+
+UniformStreamer::~UniformStreamer()
 {
 	this->Destroy();
 }
\ No newline at end of file
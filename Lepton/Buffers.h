@@ -3,6 +3,10 @@
 *************************************************************************/
 #pragma once
 
+#include <span>
+#include <deque>
+#include <vector>
+#include <type_traits>
 #include "DeviceMemory.h"
 
 namespace Lepton
@@ -23,7 +27,7 @@ namespace Lepton
 		HostVisibleBuffer();
 
 		//!	@brief	Create and initialize immediately.
-		explicit HostVisibleBuffer(const LogicalDevice * pLogicalDevice, VkDeviceSize size);
+		explicit HostVisibleBuffer(const LogicalDevice * pLogicalDevice, VkDeviceSize size, bool isPersistentlyMapped = false, MemoryUsage eUsage = MemoryUsage::eCpuOnly);
 
 		//!	@brief	Destroy buffer object.
 		~HostVisibleBuffer();
@@ -39,11 +43,37 @@ namespace Lepton
 		//!	@brief	If buffer handle is valid.
 		bool IsEmpty() const { return m_hBuffer != VK_NULL_HANDLE; }
 
+		//!	@brief	Return VkDevice handle.
+		VkDevice GetDeviceHandle() const { return m_Memory.GetDeviceHandle(); }
+
 		//!	@brief	Memory copy from device to host.
 		Result Read(void * pHostData, VkDeviceSize offset, VkDeviceSize size);
 
-		//!	@brief	Create a new buffer object.
-		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size);
+		/**
+		 *	@brief		Create a new buffer object.
+		 *	@param[in]	isPersistentlyMapped - Buffer stays mapped until destroyed (always true for non-coherent memory).
+		 *	@param[in]	eUsage - eCpuOnly for staging, eCpuToGpu for data read by the device straight from the mapping every frame (ReBAR),
+		 *						 eGpuToCpu for readback (may select cached, non-coherent memory).
+		 */
+		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size, bool isPersistentlyMapped = false, MemoryUsage eUsage = MemoryUsage::eCpuOnly);
+
+		//!	@brief	Record a range written through the mapping, flushed by the next Flush() (no-op for coherent memory).
+		void MarkDirty(VkDeviceSize offset, VkDeviceSize size);
+
+		//!	@brief	Make host writes to dirty ranges visible to the device (call once before submit).
+		Result Flush();
+
+		//!	@brief	Make device writes visible to the host (call once after the submit completed, before Read).
+		Result Invalidate(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+		//!	@brief	Flush dirty ranges of all buffers with a single vkFlushMappedMemoryRanges call (same device).
+		static Result Flush(vk::ArrayProxy<HostVisibleBuffer*> pBuffers);
+
+		//!	@brief	Invalidate all buffers with a single vkInvalidateMappedMemoryRanges call (same device).
+		static Result Invalidate(vk::ArrayProxy<HostVisibleBuffer*> pBuffers);
+
+		//!	@brief	Whether host writes are visible to the device without explicit flush.
+		bool IsCoherent() const { return bool(m_Memory.GetPropertyFlags() & vk::MemoryPropertyFlagBits::eHostCoherent); }
 
 		//!	@brief	Memory copy from host to device.
 		Result Write(const void * pHostData, VkDeviceSize offset, VkDeviceSize size);
@@ -54,16 +84,44 @@ namespace Lepton
 		//!	@brief	Return the buffer size in bytes.
 		VkDeviceSize Bytes() const { return m_Bytes; }
 
-		//!	@brief	Destroy the buffer.
+		//!	@brief	Whether the buffer is persistently mapped.
+		bool IsMapped() const { return m_pMappedData != nullptr; }
+
+		//!	@brief	Return pointer to the persistent mapping (nullptr if not persistently mapped).
+		void * MappedData() const { return m_pMappedData; }
+
+		//!	@brief	Return typed view of the persistent mapping (empty if not persistently mapped).
+		template<typename Type> std::span<Type> MappedSpan() const
+		{
+			return std::span<Type>(static_cast<Type*>(m_pMappedData), (m_pMappedData != nullptr) ? static_cast<size_t>(m_Bytes / sizeof(Type)) : 0);
+		}
+
+		//!	@brief	Destroy the buffer, the Vulkan objects are released once the device is done with them.
 		void Destroy();
 
 	private:
 
-		VkBuffer			m_hBuffer;
+		//!	@brief	Expand range to nonCoherentAtomSize boundaries, clamped to the allocation.
+		VkMappedMemoryRange GetAlignedRange(VkDeviceSize offset, VkDeviceSize size) const;
+
+		//!	@brief	Append merged dirty ranges and clear them.
+		void CollectDirtyRanges(std::vector<VkMappedMemoryRange> & MemoryRanges);
 
-		DeviceMemory		m_Memory;
+	private:
 
-		VkDeviceSize		m_Bytes;
+		VkBuffer												m_hBuffer;
+
+		DeviceMemory											m_Memory;
+
+		DeletionQueue *											m_pDeletionQueue;
+
+		VkDeviceSize											m_Bytes;
+
+		void *													m_pMappedData;
+
+		VkDeviceSize											m_NonCoherentAtomSize;
+
+		std::vector<std::pair<VkDeviceSize, VkDeviceSize>>		m_DirtyRanges;
 	};
 
 	/*********************************************************************
@@ -101,7 +159,7 @@ namespace Lepton
 		//!	@brief	Resize buffer.
 		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize sizeBytes);
 
-		//!	@brief	Destroy the buffer.
+		//!	@brief	Destroy the buffer, the Vulkan objects are released once the device is done with them.
 		void Destroy();
 
 	private:
@@ -109,5 +167,166 @@ namespace Lepton
 		VkBuffer				m_hBuffer;
 
 		DeviceLocalMemory		m_DeviceMemory;
+
+		DeletionQueue *			m_pDeletionQueue;
+	};
+
+	/*********************************************************************
+	*************************    RingBuffer    ***************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Persistently mapped ring for transient per-frame data (uniforms, dynamic vertices).
+	 *	@note	Call Retire() once per frame before the oldest in-flight fence is reset, and EndFrame() before submit.
+	 */
+	class RingBuffer
+	{
+		LAVA_NONCOPYABLE(RingBuffer)
+
+	public:
+
+		/**
+		 *	@brief	Sub-range handed out by the ring, valid until its frame retires.
+		 */
+		struct Allocation
+		{
+			VkBuffer			hBuffer			= VK_NULL_HANDLE;
+			VkDeviceSize		offset			= 0;
+			VkDeviceSize		size			= 0;
+			void *				pData			= nullptr;
+
+			//!	@brief	Whether the allocation succeeded.
+			explicit operator bool() const { return pData != nullptr; }
+		};
+
+	public:
+
+		//!	@brief	Create ring buffer object.
+		RingBuffer();
+
+		//!	@brief	Destroy ring buffer object.
+		~RingBuffer();
+
+	public:
+
+		//!	@brief	Convert to VkBuffer.
+		operator VkBuffer() const { return m_Buffer; }
+
+		//!	@brief	Return Vulkan type of this object.
+		VkBuffer Handle() const { return m_Buffer; }
+
+		//!	@brief	Return the ring capacity in bytes.
+		VkDeviceSize Bytes() const { return m_Buffer.Bytes(); }
+
+		//!	@brief	Create a new ring, default alignment is minUniformBufferOffsetAlignment (eCpuToGpu for data the device reads in place).
+		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size, MemoryUsage eUsage = MemoryUsage::eCpuOnly);
+
+		//!	@brief	Bump-allocate an aligned sub-range, fails (empty allocation) when the ring is full.
+		Allocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+
+		//!	@brief	Allocate and copy host data.
+		Allocation Upload(const void * pHostData, VkDeviceSize size, VkDeviceSize alignment = 0);
+
+		//!	@brief	Make host writes of the current frame visible to the device (no-op for coherent memory).
+		Result Flush();
+
+		//!	@brief	Close the current frame, its region is retired once hFence signals (call only after a successful submit).
+		void CloseFrame(VkFence hFence);
+
+		//!	@brief	Flush and close the current frame.
+		Result EndFrame(VkFence hFence);
+
+		//!	@brief	Reclaim regions of frames whose fences have signaled.
+		void Retire();
+
+		//!	@brief	Destroy the ring.
+		void Destroy();
+
+	private:
+
+		/**
+		 *	@brief	Frame submitted to the device, owning ring bytes up to its end.
+		 */
+		struct InFlightFrame
+		{
+			VkFence				hFence;
+			VkDeviceSize		end;
+		};
+
+	private:
+
+		HostVisibleBuffer				m_Buffer;
+
+		VkDeviceSize					m_Alignment;
+
+		VkDeviceSize					m_Head;				//!	Monotonic write position.
+
+		VkDeviceSize					m_Tail;				//!	Monotonic position of the oldest live byte.
+
+		VkDeviceSize					m_FrameBegin;		//!	Monotonic position where the current frame started.
+
+		std::deque<InFlightFrame>		m_InFlightFrames;
+	};
+
+	/*********************************************************************
+	***********************    UniformStreamer    ************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Packs per-object constants into one ring read through a single UNIFORM_BUFFER_DYNAMIC descriptor.
+	 *	@note	Write GetDescriptorInfo() into the set once, then bind it with the offset Push() returned for each object.
+	 *			Frames are retired like RingBuffer: Retire() once per frame, EndFrame() before submit.
+	 */
+	class UniformStreamer
+	{
+		LAVA_NONCOPYABLE(UniformStreamer)
+
+	public:
+
+		//!	@brief	Create uniform streamer object.
+		UniformStreamer();
+
+		//!	@brief	Destroy uniform streamer object.
+		~UniformStreamer();
+
+	public:
+
+		//!	@brief	Return Vulkan type of this object.
+		VkBuffer Handle() const { return m_Ring.Handle(); }
+
+		//!	@brief	Return the descriptor range, i.e. the largest object that can be pushed.
+		VkDeviceSize ObjectRange() const { return m_ObjectRange; }
+
+		//!	@brief	Return buffer info for the dynamic uniform buffer descriptor (offset 0, range of one object).
+		VkDescriptorBufferInfo GetDescriptorInfo() const { return { m_Ring.Handle(), 0, m_ObjectRange }; }
+
+		//!	@brief	Create a new streamer, objectRange is the uniform block size and size the ring capacity in bytes.
+		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize objectRange, VkDeviceSize size);
+
+		//!	@brief	Copy object constants into the ring and return their dynamic offset (LAVA_INVALID_INDEX if the ring is full).
+		uint32_t Push(const void * pHostData, VkDeviceSize size);
+
+		//!	@brief	Copy object constants into the ring and return their dynamic offset (LAVA_INVALID_INDEX if the ring is full).
+		template<typename Type> uint32_t Push(const Type & constants)
+		{
+			static_assert(std::is_trivially_copyable<Type>::value, "Uniform data must be trivially copyable.");
+
+			return this->Push(&constants, sizeof(Type));
+		}
+
+		//!	@brief	Close the current frame, its objects are retired once hFence signals.
+		Result EndFrame(VkFence hFence) { return m_Ring.EndFrame(hFence); }
+
+		//!	@brief	Reclaim objects of frames whose fences have signaled.
+		void Retire() { m_Ring.Retire(); }
+
+		//!	@brief	Destroy the streamer.
+		void Destroy();
+
+	private:
+
+		RingBuffer						m_Ring;
+
+		VkDeviceSize					m_ObjectRange;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*************************************************************************
+**********************    Lepton_CommandContext    ***********************
+*************************************************************************/
+
+#include <algorithm>
+#include "CommandContext.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+**********************    CommandContextManager    ***********************
+*************************************************************************/
+static std::atomic<uint64_t>		s_NextInstanceId(1);
+
+/**
+ *	@brief	Context of the calling thread for one manager, expires once the manager destroyed its contexts.
+ */
+struct ThreadContextEntry
+{
+	uint64_t					instanceId;
+	void *						pThreadContext;
+	std::weak_ptr<void>			wpThreadContext;
+};
+
+//	Contexts of the calling thread, keyed by manager instance (ids are never reused, so stale entries never match).
+static thread_local std::vector<ThreadContextEntry>		s_ThreadContexts;
+
+
+CommandContextManager::CommandContextManager() : m_InstanceId(0), m_FrameCount(1), m_FrameNumber(0)
+{
+
+}
+
+
+Result CommandContextManager::Create(uint32_t frameCount)
+{
+	if (frameCount == 0)		return Result::eErrorInitializationFailed;
+
+	this->Destroy();
+
+	m_InstanceId = s_NextInstanceId.fetch_add(1);
+
+	m_FrameCount = frameCount;
+
+	m_FrameNumber.store(0, std::memory_order_release);
+
+	return Result::eSuccess;
+}
+
+
+uint32_t CommandContextManager::BeginFrame()
+{
+	return static_cast<uint32_t>((m_FrameNumber.fetch_add(1, std::memory_order_acq_rel) + 1) % m_FrameCount);
+}
+
+
+CommandContextManager::ThreadContext * CommandContextManager::GetThreadContext()
+{
+	for (auto & entry : s_ThreadContexts)
+	{
+		if (entry.instanceId == m_InstanceId)
+		{
+			return static_cast<ThreadContext*>(entry.pThreadContext);
+		}
+	}
+
+	//	Off the hot path: drop entries of managers destroyed since, so long-lived threads don't accumulate them.
+	s_ThreadContexts.erase(std::remove_if(s_ThreadContexts.begin(), s_ThreadContexts.end(), [](const ThreadContextEntry & entry) { return entry.wpThreadContext.expired(); }), s_ThreadContexts.end());
+
+	auto spThreadContext = std::make_shared<ThreadContext>();
+
+	s_ThreadContexts.push_back({ m_InstanceId, spThreadContext.get(), spThreadContext });
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_ThreadContexts.push_back(spThreadContext);
+
+	return spThreadContext.get();
+}
+
+
+CommandBuffer * CommandContextManager::Acquire(CommandQueue * pCommandQueue, VkCommandBufferLevel eLevel)
+{
+	if (pCommandQueue == nullptr)		return nullptr;
+	if (m_InstanceId == 0)				return nullptr;
+
+	ThreadContext * pThreadContext = this->GetThreadContext();
+
+	QueuePools * pQueuePools = nullptr;
+
+	for (auto & queuePools : pThreadContext->PerQueuePools)
+	{
+		if (queuePools.pCommandQueue == pCommandQueue)
+		{
+			pQueuePools = &queuePools;
+
+			break;
+		}
+	}
+
+	if (pQueuePools == nullptr)
+	{
+		pThreadContext->PerQueuePools.emplace_back();
+
+		pQueuePools = &pThreadContext->PerQueuePools.back();
+
+		pQueuePools->pCommandQueue = pCommandQueue;
+
+		pQueuePools->FramePools.resize(m_FrameCount);
+	}
+
+	const uint64_t frameNumber = m_FrameNumber.load(std::memory_order_acquire);
+
+	FramePool & framePool = pQueuePools->FramePools[frameNumber % m_FrameCount];
+
+	if (framePool.pCommandPool == nullptr)
+	{
+		//	Whole pools are reset, so buffers don't need the individual reset flag.
+		framePool.pCommandPool = pCommandQueue->CreateCommandPool(vk::CommandPoolCreateFlagBits::eTransient);
+
+		if (framePool.pCommandPool == nullptr)		return nullptr;
+
+		framePool.frameNumber = frameNumber;
+	}
+	else if (framePool.frameNumber != frameNumber)
+	{
+		//	First use of this slot in the new frame, its previous submissions have completed.
+		if (framePool.pCommandPool->Reset(0) != Result::eSuccess)		return nullptr;
+
+		framePool.frameNumber = frameNumber;
+
+		framePool.primaryCount = 0;
+
+		framePool.secondaryCount = 0;
+	}
+
+	const bool isPrimary = (eLevel == VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+	std::vector<CommandBuffer*> & pCommandBuffers = isPrimary ? framePool.pPrimaries : framePool.pSecondaries;
+
+	uint32_t & usedCount = isPrimary ? framePool.primaryCount : framePool.secondaryCount;
+
+	if (usedCount == pCommandBuffers.size())
+	{
+		//	Grow geometrically so steady-state frames never allocate.
+		const size_t growCount = std::max<size_t>(4, pCommandBuffers.size());
+
+		for (size_t i = 0; i < growCount; i++)
+		{
+			CommandBuffer * pCommandBuffer = isPrimary ? framePool.pCommandPool->AllocatePrimaryCommandBuffer() : framePool.pCommandPool->AllocateSecondaryCommandBuffer();
+
+			if (pCommandBuffer == nullptr)		break;
+
+			pCommandBuffers.push_back(pCommandBuffer);
+		}
+
+		if (usedCount == pCommandBuffers.size())		return nullptr;
+	}
+
+	return pCommandBuffers[usedCount++];
+}
+
+
+void CommandContextManager::Destroy()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	for (auto & pThreadContext : m_ThreadContexts)
+	{
+		for (auto & queuePools : pThreadContext->PerQueuePools)
+		{
+			for (auto & framePool : queuePools.FramePools)
+			{
+				if (framePool.pCommandPool != nullptr)
+				{
+					queuePools.pCommandQueue->DestroyCommandPool(framePool.pCommandPool);
+				}
+			}
+		}
+	}
+
+	m_ThreadContexts.clear();
+
+	m_InstanceId = 0;
+}
+
+
+CommandContextManager::~CommandContextManager()
+{
+	this->Destroy();
+}
\ No newline at end of file
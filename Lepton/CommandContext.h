@@ -0,0 +1,105 @@
+/*************************************************************************
+**********************    Lepton_CommandContext    ***********************
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include "Commands.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	********************    CommandContextManager    *********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Hands out command buffers from lazily created pools, one per (thread, queue, frame slot).
+	 *	@note	Pools are reset as a whole on their first use in a new frame, call BeginFrame() only after the
+	 *			submissions of the slot it switches to have completed. Buffers must not be reset individually.
+	 */
+	class CommandContextManager
+	{
+		LAVA_NONCOPYABLE(CommandContextManager)
+
+	public:
+
+		//!	@brief	Create command context manager object.
+		CommandContextManager();
+
+		//!	@brief	Destroy command context manager object.
+		~CommandContextManager();
+
+	public:
+
+		//!	@brief	Create a new manager cycling through frameCount slots.
+		Result Create(uint32_t frameCount = 2);
+
+		//!	@brief	Advance to the next frame slot and return its index.
+		uint32_t BeginFrame();
+
+		//!	@brief	Return the index of the current frame slot.
+		uint32_t FrameIndex() const { return static_cast<uint32_t>(m_FrameNumber.load(std::memory_order_acquire) % m_FrameCount); }
+
+		//!	@brief	Return a primary command buffer of the calling thread for this frame (lock free unless the pool is new).
+		CommandBuffer * AcquirePrimary(CommandQueue * pCommandQueue) { return this->Acquire(pCommandQueue, VK_COMMAND_BUFFER_LEVEL_PRIMARY); }
+
+		//!	@brief	Return a secondary command buffer of the calling thread for this frame (lock free unless the pool is new).
+		CommandBuffer * AcquireSecondary(CommandQueue * pCommandQueue) { return this->Acquire(pCommandQueue, VK_COMMAND_BUFFER_LEVEL_SECONDARY); }
+
+		//!	@brief	Destroy all pools, no thread may record from them anymore.
+		void Destroy();
+
+	private:
+
+		/**
+		 *	@brief	Pool of one frame slot with its pre-allocated command buffers.
+		 */
+		struct FramePool
+		{
+			CommandPool *							pCommandPool		= nullptr;
+			uint64_t								frameNumber			= UINT64_MAX;
+			uint32_t								primaryCount		= 0;
+			uint32_t								secondaryCount		= 0;
+			std::vector<CommandBuffer*>				pPrimaries;
+			std::vector<CommandBuffer*>				pSecondaries;
+		};
+
+		/**
+		 *	@brief	Frame pools of one queue.
+		 */
+		struct QueuePools
+		{
+			CommandQueue *							pCommandQueue		= nullptr;
+			std::vector<FramePool>					FramePools;
+		};
+
+		/**
+		 *	@brief	Everything owned by one recording thread.
+		 */
+		struct ThreadContext
+		{
+			std::vector<QueuePools>					PerQueuePools;
+		};
+
+	private:
+
+		//!	@brief	Return the context of the calling thread, created on first use.
+		ThreadContext * GetThreadContext();
+
+		//!	@brief	Return the next free command buffer of the given level.
+		CommandBuffer * Acquire(CommandQueue * pCommandQueue, VkCommandBufferLevel eLevel);
+
+	private:
+
+		std::mutex										m_Mutex;
+
+		uint64_t										m_InstanceId;
+
+		uint32_t										m_FrameCount;
+
+		std::atomic<uint64_t>							m_FrameNumber;
+
+		std::vector<std::shared_ptr<ThreadContext>>		m_ThreadContexts;		//!	Threads only hold weak references, they expire on Destroy().
+	};
+}
\ No newline at end of file
@@ -2,8 +2,11 @@
 *************************    Lepton_Commands    **************************
 *************************************************************************/
 
+#include <algorithm>
 #include "Commands.h"
 #include "Framebuffer.h"
+#include "DeletionQueue.h"
+#include "DescriptorWriter.h"
 
 using namespace Lepton;
 
@@ -11,7 +14,11 @@ using namespace Lepton;
 ***************************    CommandQueue    ***************************
 *************************************************************************/
 CommandQueue::CommandQueue(uint32_t familyIndex, vk::QueueFlags eCapabilities, float priority)
-	: m_hDevice(VK_NULL_HANDLE), m_hQueue(VK_NULL_HANDLE), m_FamilyIndex(familyIndex), m_eCapabilities(eCapabilities), m_Priority(priority)
+	: m_hDevice(VK_NULL_HANDLE), m_hQueue(VK_NULL_HANDLE), m_pDeletionQueue(nullptr), m_HasUnfencedWork(false), m_pfnCmdPushDescriptorSet(nullptr), m_pfnCmdPushDescriptorSetWithTemplate(nullptr),
+#ifdef VK_EXT_descriptor_buffer
+	m_pfnCmdBindDescriptorBuffers(nullptr), m_pfnCmdSetDescriptorBufferOffsets(nullptr),
+#endif
+	m_FamilyIndex(familyIndex), m_eCapabilities(eCapabilities), m_Priority(priority)
 {
 
 }
@@ -29,7 +36,9 @@ CommandPool * CommandQueue::CreateCommandPool(vk::CommandPoolCreateFlags eUsageB
 
 	if (vkCreateCommandPool(m_hDevice, &CreateInfo, nullptr, &hCommandPool) == VK_SUCCESS)
 	{
-		CommandPool * pCommandPool = new CommandPool(m_hDevice, m_hQueue, hCommandPool, eUsageBehaviors);
+		CommandPool * pCommandPool = new CommandPool(m_hDevice, this, hCommandPool, eUsageBehaviors, m_pDeletionQueue);
+
+		std::lock_guard<std::mutex> lock(m_PoolMutex);
 
 		m_pCommandPools.insert(pCommandPool);
 
@@ -40,16 +49,58 @@ CommandPool * CommandQueue::CreateCommandPool(vk::CommandPoolCreateFlags eUsageB
 }
 
 
+Result CommandQueue::Submit(uint32_t submitCount, const VkSubmitInfo * pSubmits, VkFence hFence)
+{
+	Result eResult = Result::eSuccess;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		eResult = LAVA_RESULT_CAST(vkQueueSubmit(m_hQueue, submitCount, pSubmits, hFence));
+
+		m_HasUnfencedWork |= (eResult == Result::eSuccess);
+	}
+
+	//	Outside the queue lock, closing an epoch fences every queue.
+	m_pDeletionQueue->Advance();
+
+	m_pDeletionQueue->Collect();
+
+	return eResult;
+}
+
+
+bool CommandQueue::SubmitEpochFence(VkFence hFence)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	if (!m_HasUnfencedWork)		return false;
+
+	m_HasUnfencedWork = false;
+
+	if ((hFence != VK_NULL_HANDLE) && (vkQueueSubmit(m_hQueue, 0, nullptr, hFence) == VK_SUCCESS))
+	{
+		return true;
+	}
+
+	//	No fence to wait on later, drain the queue now instead.
+	vkQueueWaitIdle(m_hQueue);
+
+	return false;
+}
+
+
 Result CommandQueue::DestroyCommandPool(CommandPool * pCommandPool)
 {
-	if (m_pCommandPools.erase(pCommandPool) != 0)
 	{
-		delete pCommandPool;
+		std::lock_guard<std::mutex> lock(m_PoolMutex);
 
-		return Result::eSuccess;
+		if (m_pCommandPools.erase(pCommandPool) == 0)		return Result::eErrorInvalidDeviceHandle;
 	}
 
-	return Result::eErrorInvalidDeviceHandle;
+	delete pCommandPool;
+
+	return Result::eSuccess;
 }
 
 
@@ -65,27 +116,47 @@ CommandQueue::~CommandQueue() noexcept
 /*************************************************************************
 ***************************    CommandPool    ****************************
 *************************************************************************/
-CommandPool::CommandPool(VkDevice hDevice, VkQueue hQueue, VkCommandPool hCommnadPool, vk::CommandPoolCreateFlags eUsageBehaviors)
-	: m_hDevice(hDevice), m_hQueue(hQueue), m_hCommandPool(hCommnadPool), m_eUsageBehaviors(eUsageBehaviors)
+CommandPool::CommandPool(VkDevice hDevice, CommandQueue * pCommandQueue, VkCommandPool hCommnadPool, vk::CommandPoolCreateFlags eUsageBehaviors, DeletionQueue * pDeletionQueue)
+	: m_hDevice(hDevice), m_pCommandQueue(pCommandQueue), m_hCommandPool(hCommnadPool), m_eUsageBehaviors(eUsageBehaviors), m_pDeletionQueue(pDeletionQueue),
+	m_spReleasedCommandBuffers(std::make_shared<ReleasedCommandBuffers>())
 {
 
 }
 
 
-CommandBuffer * CommandPool::AllocatePrimaryCommandBuffer()
+void CommandPool::FreeReleasedCommandBuffers()
+{
+	std::vector<VkCommandBuffer> hCommandBuffers;
+
+	{
+		std::lock_guard<std::mutex> lock(m_spReleasedCommandBuffers->Mutex);
+
+		hCommandBuffers.swap(m_spReleasedCommandBuffers->hCommandBuffers);
+	}
+
+	if (!hCommandBuffers.empty())
+	{
+		vkFreeCommandBuffers(m_hDevice, m_hCommandPool, static_cast<uint32_t>(hCommandBuffers.size()), hCommandBuffers.data());
+	}
+}
+
+
+CommandBuffer * CommandPool::AllocateCommandBuffer(VkCommandBufferLevel eLevel)
 {
+	this->FreeReleasedCommandBuffers();
+
 	VkCommandBufferAllocateInfo			AllocateInfo = {};
 	AllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	AllocateInfo.pNext					= nullptr;
 	AllocateInfo.commandPool			= m_hCommandPool;
-	AllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	AllocateInfo.level					= eLevel;
 	AllocateInfo.commandBufferCount		= 1;
 
 	VkCommandBuffer hCommandBuffer = VK_NULL_HANDLE;
 
 	if (vkAllocateCommandBuffers(m_hDevice, &AllocateInfo, &hCommandBuffer) == VK_SUCCESS)
 	{
-		CommandBuffer * pCommandBuffer = new CommandBuffer(m_hQueue, hCommandBuffer);
+		CommandBuffer * pCommandBuffer = new CommandBuffer(m_pCommandQueue, hCommandBuffer);
 
 		m_pCommandBuffers.insert(pCommandBuffer);
 
@@ -98,13 +169,19 @@ CommandBuffer * CommandPool::AllocatePrimaryCommandBuffer()
 
 Result CommandPool::FreeCommandBuffer(CommandBuffer * pCommandBuffer)
 {
+	this->FreeReleasedCommandBuffers();
+
 	if (m_pCommandBuffers.erase(pCommandBuffer) != 0)
 	{
-		vkQueueWaitIdle(m_hQueue);
-
 		VkCommandBuffer hCommandBuffer = pCommandBuffer->m_hCommandBuffer;
 
-		vkFreeCommandBuffers(m_hDevice, m_hCommandPool, 1, &hCommandBuffer);
+		//	The pool is externally synchronized, so the deleter only hands the buffer back to the owner thread.
+		m_pDeletionQueue->Enqueue([spReleasedCommandBuffers = m_spReleasedCommandBuffers, hCommandBuffer]()
+		{
+			std::lock_guard<std::mutex> lock(spReleasedCommandBuffers->Mutex);
+
+			spReleasedCommandBuffers->hCommandBuffers.push_back(hCommandBuffer);
+		});
 
 		delete pCommandBuffer;
 
@@ -117,7 +194,12 @@ Result CommandPool::FreeCommandBuffer(CommandBuffer * pCommandBuffer)
 
 CommandPool::~CommandPool() noexcept
 {
-	vkDestroyCommandPool(m_hDevice, m_hCommandPool, nullptr);
+	VkDevice hDevice = m_hDevice;
+
+	VkCommandPool hCommandPool = m_hCommandPool;
+
+	//	Nobody records from the pool anymore, so it can be destroyed from any thread (this frees released buffers as well).
+	m_pDeletionQueue->Enqueue([=]() { vkDestroyCommandPool(hDevice, hCommandPool, nullptr); });
 
 	for (auto pCommandBuffer : m_pCommandBuffers)
 	{
@@ -129,8 +211,8 @@ CommandPool::~CommandPool() noexcept
 /*************************************************************************
 **************************    CommandBuffer    ***************************
 *************************************************************************/
-CommandBuffer::CommandBuffer(VkQueue hQueue, VkCommandBuffer hCommandBuffer)
-	: m_hQueue(hQueue), m_hCommandBuffer(hCommandBuffer)
+CommandBuffer::CommandBuffer(CommandQueue * pCommandQueue, VkCommandBuffer hCommandBuffer)
+	: m_pCommandQueue(pCommandQueue), m_hCommandBuffer(hCommandBuffer)
 {
 	m_SubmitInfo.sType						= VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	m_SubmitInfo.pNext						= nullptr;
@@ -141,6 +223,224 @@ CommandBuffer::CommandBuffer(VkQueue hQueue, VkCommandBuffer hCommandBuffer)
 	m_SubmitInfo.pCommandBuffers			= &m_hCommandBuffer;
 	m_SubmitInfo.signalSemaphoreCount		= 0;
 	m_SubmitInfo.pSignalSemaphores			= nullptr;
+
+	this->ResetBindings();
+}
+
+
+void CommandBuffer::CmdBindDescriptorSets(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, vk::ArrayProxy<VkDescriptorSet> pDescriptorSets,
+										  uint32_t firstSet, vk::ArrayProxy<const uint32_t> pDynamicOffsets)
+{
+	const uint32_t bindPoint = static_cast<uint32_t>(ePipelineBindPoint);
+
+	//	Pipelines sharing an (interned) layout keep the sets bound, rebinding them would be redundant.
+	//	Dynamic offsets usually change per draw, such binds are never skipped and never matched.
+	if ((bindPoint < 2) && (pDescriptorSets.size() <= MaxTrackedSets) && pDynamicOffsets.empty())
+	{
+		BoundDescriptorSets & boundSets = m_BoundDescriptorSets[bindPoint];
+
+		if ((boundSets.hPipelineLayout == hPipelineLayout) && (boundSets.firstSet == firstSet) && (boundSets.setCount == pDescriptorSets.size()) &&
+			std::equal(pDescriptorSets.begin(), pDescriptorSets.end(), boundSets.hDescriptorSets))
+		{
+			return;
+		}
+
+		boundSets.hPipelineLayout = hPipelineLayout;
+
+		boundSets.firstSet = firstSet;
+
+		boundSets.setCount = pDescriptorSets.size();
+
+		std::copy(pDescriptorSets.begin(), pDescriptorSets.end(), boundSets.hDescriptorSets);
+	}
+	else if (bindPoint < 2)
+	{
+		m_BoundDescriptorSets[bindPoint].hPipelineLayout = VK_NULL_HANDLE;
+	}
+
+	vkCmdBindDescriptorSets(m_hCommandBuffer, static_cast<VkPipelineBindPoint>(ePipelineBindPoint), hPipelineLayout, firstSet,
+							pDescriptorSets.size(), pDescriptorSets.data(), pDynamicOffsets.size(), pDynamicOffsets.data());
+}
+
+
+Result CommandBuffer::CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, vk::ArrayProxy<const VkWriteDescriptorSet> pWrites)
+{
+	if (m_pCommandQueue->m_pfnCmdPushDescriptorSet == nullptr)		return Result::eErrorExtensionNotPresent;
+	if (pWrites.empty())											return Result::eSuccess;
+
+	this->ResetBindings(ePipelineBindPoint);
+
+	m_pCommandQueue->m_pfnCmdPushDescriptorSet(m_hCommandBuffer, static_cast<VkPipelineBindPoint>(ePipelineBindPoint), hPipelineLayout, set, pWrites.size(), pWrites.data());
+
+	return Result::eSuccess;
+}
+
+
+Result CommandBuffer::CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, uint32_t binding, vk::DescriptorType eType, vk::ArrayProxy<const VkDescriptorImageInfo> pImageInfos)
+{
+	VkWriteDescriptorSet				Write = {};
+	Write.sType							= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	Write.pNext							= nullptr;
+	Write.dstSet						= VK_NULL_HANDLE;
+	Write.dstBinding					= binding;
+	Write.dstArrayElement				= 0;
+	Write.descriptorCount				= pImageInfos.size();
+	Write.descriptorType				= static_cast<VkDescriptorType>(eType);
+	Write.pImageInfo					= pImageInfos.data();
+	Write.pBufferInfo					= nullptr;
+	Write.pTexelBufferView				= nullptr;
+
+	return this->CmdPushDescriptorSet(ePipelineBindPoint, hPipelineLayout, set, Write);
+}
+
+
+Result CommandBuffer::CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, uint32_t binding, vk::DescriptorType eType, vk::ArrayProxy<const VkDescriptorBufferInfo> pBufferInfos)
+{
+	VkWriteDescriptorSet				Write = {};
+	Write.sType							= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	Write.pNext							= nullptr;
+	Write.dstSet						= VK_NULL_HANDLE;
+	Write.dstBinding					= binding;
+	Write.dstArrayElement				= 0;
+	Write.descriptorCount				= pBufferInfos.size();
+	Write.descriptorType				= static_cast<VkDescriptorType>(eType);
+	Write.pImageInfo					= nullptr;
+	Write.pBufferInfo					= pBufferInfos.data();
+	Write.pTexelBufferView				= nullptr;
+
+	return this->CmdPushDescriptorSet(ePipelineBindPoint, hPipelineLayout, set, Write);
+}
+
+
+Result CommandBuffer::CmdPushDescriptorSet(const DescriptorUpdateTemplate & updateTemplate, const void * pData)
+{
+	if (m_pCommandQueue->m_pfnCmdPushDescriptorSetWithTemplate == nullptr)		return Result::eErrorExtensionNotPresent;
+	if (!updateTemplate.IsPushTemplate())										return Result::eErrorInvalidPipelineLayoutHandle;
+
+	this->ResetBindings(updateTemplate.GetPipelineBindPoint());
+
+	m_pCommandQueue->m_pfnCmdPushDescriptorSetWithTemplate(m_hCommandBuffer, updateTemplate.Handle(), updateTemplate.GetPipelineLayout(), updateTemplate.GetSet(), pData);
+
+	return Result::eSuccess;
+}
+
+
+#ifdef VK_EXT_descriptor_buffer
+
+void CommandBuffer::CmdBindDescriptorBuffers(vk::ArrayProxy<const VkDescriptorBufferBindingInfoEXT> pBindingInfos)
+{
+	this->ResetBindings();
+
+	m_pCommandQueue->m_pfnCmdBindDescriptorBuffers(m_hCommandBuffer, pBindingInfos.size(), pBindingInfos.data());
+}
+
+
+void CommandBuffer::CmdSetDescriptorBufferOffsets(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t firstSet,
+												  vk::ArrayProxy<const uint32_t> pBufferIndices, vk::ArrayProxy<const VkDeviceSize> pOffsets)
+{
+	if (pBufferIndices.size() != pOffsets.size())		return;
+
+	this->ResetBindings(ePipelineBindPoint);
+
+	m_pCommandQueue->m_pfnCmdSetDescriptorBufferOffsets(m_hCommandBuffer, static_cast<VkPipelineBindPoint>(ePipelineBindPoint), hPipelineLayout, firstSet, pOffsets.size(), pBufferIndices.data(), pOffsets.data());
+}
+
+#endif
+
+
+Result CommandBuffer::Submit(vk::ArrayProxy<const SemaphoreSubmit> pWaitSemaphores, vk::ArrayProxy<const SemaphoreSubmit> pSignalSemaphores, VkFence hFence)
+{
+	std::vector<VkSemaphore>				hWaitSemaphores(pWaitSemaphores.size());
+	std::vector<VkSemaphore>				hSignalSemaphores(pSignalSemaphores.size());
+	std::vector<VkPipelineStageFlags>		eWaitDstStageMasks(pWaitSemaphores.size());
+	std::vector<uint64_t>					WaitValues(pWaitSemaphores.size());
+	std::vector<uint64_t>					SignalValues(pSignalSemaphores.size());
+
+	bool hasTimelineValue = false;
+
+	for (uint32_t i = 0; i < pWaitSemaphores.size(); i++)
+	{
+		hWaitSemaphores[i]			= pWaitSemaphores.data()[i].hSemaphore;
+		eWaitDstStageMasks[i]		= VkFlags(pWaitSemaphores.data()[i].eStageMask);
+		WaitValues[i]				= pWaitSemaphores.data()[i].value;
+		hasTimelineValue			|= (WaitValues[i] != 0);
+	}
+
+	for (uint32_t i = 0; i < pSignalSemaphores.size(); i++)
+	{
+		hSignalSemaphores[i]		= pSignalSemaphores.data()[i].hSemaphore;
+		SignalValues[i]				= pSignalSemaphores.data()[i].value;
+		hasTimelineValue			|= (SignalValues[i] != 0);
+	}
+
+	VkTimelineSemaphoreSubmitInfoKHR				TimelineInfo = {};
+	TimelineInfo.sType								= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+	TimelineInfo.pNext								= nullptr;
+	TimelineInfo.waitSemaphoreValueCount			= static_cast<uint32_t>(WaitValues.size());
+	TimelineInfo.pWaitSemaphoreValues				= WaitValues.data();
+	TimelineInfo.signalSemaphoreValueCount			= static_cast<uint32_t>(SignalValues.size());
+	TimelineInfo.pSignalSemaphoreValues				= SignalValues.data();
+
+	//	Only chained when needed, so plain binary submissions work without the extension.
+	VkSubmitInfo									SubmitInfo = {};
+	SubmitInfo.sType								= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	SubmitInfo.pNext								= hasTimelineValue ? &TimelineInfo : nullptr;
+	SubmitInfo.waitSemaphoreCount					= static_cast<uint32_t>(hWaitSemaphores.size());
+	SubmitInfo.pWaitSemaphores						= hWaitSemaphores.data();
+	SubmitInfo.pWaitDstStageMask					= eWaitDstStageMasks.data();
+	SubmitInfo.commandBufferCount					= 1;
+	SubmitInfo.pCommandBuffers						= &m_hCommandBuffer;
+	SubmitInfo.signalSemaphoreCount					= static_cast<uint32_t>(hSignalSemaphores.size());
+	SubmitInfo.pSignalSemaphores					= hSignalSemaphores.data();
+
+	return m_pCommandQueue->Submit(1, &SubmitInfo, hFence);
+}
+
+
+Result CommandBuffer::BeginRecord(const Framebuffer & framebuffer, uint32_t subpass, vk::CommandBufferUsageFlags eUsages)
+{
+	if (!framebuffer.IsValid())		return Result::eErrorInvalidRenderPassHandle;
+
+	VkCommandBufferInheritanceInfo				InheritanceInfo = {};
+	InheritanceInfo.sType						= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	InheritanceInfo.pNext						= nullptr;
+	InheritanceInfo.renderPass					= framebuffer.GetRenderPass();
+	InheritanceInfo.subpass						= subpass;
+	InheritanceInfo.framebuffer					= framebuffer;
+	InheritanceInfo.occlusionQueryEnable		= VK_FALSE;
+	InheritanceInfo.queryFlags					= 0;
+	InheritanceInfo.pipelineStatistics			= 0;
+
+	VkCommandBufferBeginInfo					BeginInfo = {};
+	BeginInfo.sType								= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	BeginInfo.pNext								= nullptr;
+	BeginInfo.flags								= VkFlags(eUsages);
+	BeginInfo.pInheritanceInfo					= &InheritanceInfo;
+
+	this->ResetBindings();
+
+	return LAVA_RESULT_CAST(vkBeginCommandBuffer(m_hCommandBuffer, &BeginInfo));
+}
+
+
+void CommandBuffer::CmdExecuteCommands(vk::ArrayProxy<CommandBuffer* const> pCommandBuffers)
+{
+	std::vector<VkCommandBuffer> hCommandBuffers;
+
+	hCommandBuffers.reserve(pCommandBuffers.size());
+
+	for (auto pCommandBuffer : pCommandBuffers)
+	{
+		hCommandBuffers.push_back(pCommandBuffer->Handle());
+	}
+
+	if (!hCommandBuffers.empty())
+	{
+		vkCmdExecuteCommands(m_hCommandBuffer, static_cast<uint32_t>(hCommandBuffers.size()), hCommandBuffers.data());
+
+		//	Bindings are undefined after secondary command buffers ran, on every bind point.
+		this->ResetBindings();
+	}
 }
 
 
@@ -163,4 +463,117 @@ void CommandBuffer::CmdBeginRenderPass(Framebuffer framebuffer, VkRect2D renderA
 CommandBuffer::~CommandBuffer() noexcept
 {
 	
+}
+
+
+/*************************************************************************
+***************************    SubmitBatch    ****************************
+*************************************************************************/
+SubmitBatch::SubmitBatch(CommandQueue * pCommandQueue) : m_pCommandQueue(pCommandQueue)
+{
+
+}
+
+
+void SubmitBatch::Add(vk::ArrayProxy<CommandBuffer* const> pCommandBuffers, vk::ArrayProxy<const SemaphoreSubmit> pWaitSemaphores, vk::ArrayProxy<const SemaphoreSubmit> pSignalSemaphores)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	//	Command buffers without waits can join a previous entry that has no semaphore operations at all.
+	const bool canMerge = !m_Entries.empty() && (pWaitSemaphores.size() == 0) &&
+						  m_Entries.back().hWaitSemaphores.empty() && m_Entries.back().hSignalSemaphores.empty();
+
+	if (!canMerge)
+	{
+		m_Entries.emplace_back();
+	}
+
+	Entry & entry = m_Entries.back();
+
+	for (auto pCommandBuffer : pCommandBuffers)
+	{
+		entry.hCommandBuffers.push_back(pCommandBuffer->Handle());
+	}
+
+	for (auto & WaitSemaphore : pWaitSemaphores)
+	{
+		entry.hWaitSemaphores.push_back(WaitSemaphore.hSemaphore);
+
+		entry.eWaitDstStageMasks.push_back(VkFlags(WaitSemaphore.eStageMask));
+
+		entry.WaitValues.push_back(WaitSemaphore.value);
+	}
+
+	for (auto & SignalSemaphore : pSignalSemaphores)
+	{
+		entry.hSignalSemaphores.push_back(SignalSemaphore.hSemaphore);
+
+		entry.SignalValues.push_back(SignalSemaphore.value);
+	}
+}
+
+
+Result SubmitBatch::Flush(VkFence hFence)
+{
+	std::vector<Entry> Entries;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		Entries.swap(m_Entries);
+	}
+
+	//	A fence alone still needs a submission to be signaled.
+	if (Entries.empty() && (hFence == VK_NULL_HANDLE))		return Result::eSuccess;
+
+	std::vector<VkSubmitInfo>						SubmitInfos(Entries.size());
+	std::vector<VkTimelineSemaphoreSubmitInfoKHR>	TimelineInfos(Entries.size());
+
+	for (size_t i = 0; i < Entries.size(); i++)
+	{
+		bool hasTimelineValue = false;
+
+		for (auto value : Entries[i].WaitValues)		hasTimelineValue |= (value != 0);
+		for (auto value : Entries[i].SignalValues)		hasTimelineValue |= (value != 0);
+
+		TimelineInfos[i].sType							= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+		TimelineInfos[i].pNext							= nullptr;
+		TimelineInfos[i].waitSemaphoreValueCount		= static_cast<uint32_t>(Entries[i].WaitValues.size());
+		TimelineInfos[i].pWaitSemaphoreValues			= Entries[i].WaitValues.data();
+		TimelineInfos[i].signalSemaphoreValueCount		= static_cast<uint32_t>(Entries[i].SignalValues.size());
+		TimelineInfos[i].pSignalSemaphoreValues			= Entries[i].SignalValues.data();
+
+		SubmitInfos[i].sType							= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		SubmitInfos[i].pNext							= hasTimelineValue ? &TimelineInfos[i] : nullptr;
+		SubmitInfos[i].waitSemaphoreCount				= static_cast<uint32_t>(Entries[i].hWaitSemaphores.size());
+		SubmitInfos[i].pWaitSemaphores					= Entries[i].hWaitSemaphores.data();
+		SubmitInfos[i].pWaitDstStageMask				= Entries[i].eWaitDstStageMasks.data();
+		SubmitInfos[i].commandBufferCount				= static_cast<uint32_t>(Entries[i].hCommandBuffers.size());
+		SubmitInfos[i].pCommandBuffers					= Entries[i].hCommandBuffers.data();
+		SubmitInfos[i].signalSemaphoreCount				= static_cast<uint32_t>(Entries[i].hSignalSemaphores.size());
+		SubmitInfos[i].pSignalSemaphores				= Entries[i].hSignalSemaphores.data();
+	}
+
+	return m_pCommandQueue->Submit(static_cast<uint32_t>(SubmitInfos.size()), SubmitInfos.data(), hFence);
+}
+
+
+size_t SubmitBatch::CommandBufferCount() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	size_t commandBufferCount = 0;
+
+	for (auto & entry : m_Entries)
+	{
+		commandBufferCount += entry.hCommandBuffers.size();
+	}
+
+	return commandBufferCount;
+}
+
+
+SubmitBatch::~SubmitBatch()
+{
+
 }
\ No newline at end of file
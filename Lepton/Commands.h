@@ -3,7 +3,10 @@
 *************************************************************************/
 #pragma once
 
+#include <mutex>
+#include "Sync.h"
 #include "Framebuffer.h"
+#include "ComputePipeline.h"
 #include "GraphicsPipeline.h"
 
 namespace Lepton
@@ -17,6 +20,8 @@ namespace Lepton
 	 */
 	class CommandQueue
 	{
+		friend class CommandBuffer;
+		friend class DeletionQueue;
 		friend class LogicalDevice;
 
 	private:
@@ -36,7 +41,23 @@ namespace Lepton
 		float GetPriority() const { return m_Priority; }
 
 		//!	@brief	Wait for a queue to become idle.
-		void WaitIdle() const { vkQueueWaitIdle(m_hQueue); }
+		void WaitIdle() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			vkQueueWaitIdle(m_hQueue);
+		}
+
+		//!	@brief	Submit to the queue, serialized with other submissions from any thread (also advances the device's deletion queue).
+		Result Submit(uint32_t submitCount, const VkSubmitInfo * pSubmits, VkFence hFence);
+
+		//!	@brief	Queue images for presentation, serialized with submissions from any thread (see Swapchain::Present).
+		Result Present(const VkPresentInfoKHR & presentInfo)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			return LAVA_RESULT_CAST(vkQueuePresentKHR(m_hQueue, &presentInfo));
+		}
 
 		//!	@brief	Return the queue family index.
 		uint32_t GetFamilyIndex() const { return m_FamilyIndex; }
@@ -44,21 +65,47 @@ namespace Lepton
 		//!	@brief	If queue is ready to work.
 		bool IsReady() const { return m_hQueue != VK_NULL_HANDLE; }
 
+		//!	@brief	If VK_KHR_push_descriptor was enabled, otherwise CommandBuffer::CmdPushDescriptorSet() fails with eErrorExtensionNotPresent.
+		bool SupportsPushDescriptors() const { return (m_pfnCmdPushDescriptorSet != nullptr) && (m_pfnCmdPushDescriptorSetWithTemplate != nullptr); }
+
 		//!	@brief	If this queue has the specify capability.
 		bool Has(vk::QueueFlagBits eCapabilities) const { return bool(m_eCapabilities & eCapabilities); }
 
-		//!	@brief	Create a new command pool object.
+		//!	@brief	Create a new command pool object (thread safe, the pool itself must be used by one thread at a time).
 		CommandPool * CreateCommandPool(vk::CommandPoolCreateFlags eUsageBehaviors = vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
 
-		//!	@brief	Destroy a command pool object.
+		//!	@brief	Destroy a command pool object, thread safe (Vulkan object is released through the deletion queue).
 		Result DestroyCommandPool(CommandPool * pCommandPool);
 
 	private:
 
+		//!	@brief	Submit hFence behind all work since the last call, return false if there was none (waits idle if hFence is null).
+		bool SubmitEpochFence(VkFence hFence);
+
+	private:
+
+		mutable std::mutex					m_Mutex;
+
+		std::mutex							m_PoolMutex;
+
 		VkQueue								m_hQueue;
 
 		VkDevice							m_hDevice;
 
+		DeletionQueue *						m_pDeletionQueue;
+
+		bool								m_HasUnfencedWork;
+
+		PFN_vkCmdPushDescriptorSetKHR		m_pfnCmdPushDescriptorSet;
+
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR	m_pfnCmdPushDescriptorSetWithTemplate;
+
+#ifdef VK_EXT_descriptor_buffer
+		PFN_vkCmdBindDescriptorBuffersEXT			m_pfnCmdBindDescriptorBuffers;
+
+		PFN_vkCmdSetDescriptorBufferOffsetsEXT		m_pfnCmdSetDescriptorBufferOffsets;
+#endif
+
 		const float							m_Priority;
 
 		const uint32_t						m_FamilyIndex;
@@ -82,7 +129,7 @@ namespace Lepton
 	private:
 
 		//!	@brief	Create command pool object.
-		CommandPool(VkDevice hDevice, VkQueue hQueue, VkCommandPool hCommnadPool, vk::CommandPoolCreateFlags eUsageBehaviors);
+		CommandPool(VkDevice hDevice, CommandQueue * pCommandQueue, VkCommandPool hCommnadPool, vk::CommandPoolCreateFlags eUsageBehaviors, DeletionQueue * pDeletionQueue);
 
 		//!	@brief	Destroy command pool object.
 		~CommandPool() noexcept;
@@ -92,24 +139,55 @@ namespace Lepton
 		//!	@brief	Return Vulkan type of this object.
 		VkCommandPool Handle() const { return m_hCommandPool; }
 
-		//!	@brief	Reset command pool.
-		Result Reset() { return LAVA_RESULT_CAST(vkResetCommandPool(m_hDevice, m_hCommandPool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT)); }
+		//!	@brief	Reset command pool (pass 0 to keep the memory for re-recording).
+		Result Reset(VkCommandPoolResetFlags eResetFlags = VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT)
+		{
+			this->FreeReleasedCommandBuffers();
+
+			return LAVA_RESULT_CAST(vkResetCommandPool(m_hDevice, m_hCommandPool, eResetFlags));
+		}
 
-		//!	@brief	Free command buffer.
+		//!	@brief	Free command buffer, the handle is released once pending executions have completed.
 		Result FreeCommandBuffer(CommandBuffer * pCommandBuffer);
 
 		//!	@brief	Allocate a primary command buffer from command pool.
-		CommandBuffer * AllocatePrimaryCommandBuffer();
+		CommandBuffer * AllocatePrimaryCommandBuffer() { return this->AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY); }
+
+		//!	@brief	Allocate a secondary command buffer from command pool, executed by CmdExecuteCommands of a primary one.
+		CommandBuffer * AllocateSecondaryCommandBuffer() { return this->AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY); }
 
 	private:
 
-		const VkQueue							m_hQueue;
+		//!	@brief	Allocate a command buffer of the given level.
+		CommandBuffer * AllocateCommandBuffer(VkCommandBufferLevel eLevel);
+
+		//!	@brief	Free command buffers the deletion queue has released, on the thread using the pool.
+		void FreeReleasedCommandBuffers();
+
+	private:
+
+		/**
+		 *	@brief	Command buffers whose executions have completed, shared with pending deleters (which may outlive the pool).
+		 */
+		struct ReleasedCommandBuffers
+		{
+			std::mutex								Mutex;
+			std::vector<VkCommandBuffer>			hCommandBuffers;
+		};
+
+	private:
+
+		CommandQueue * const					m_pCommandQueue;
 
 		const VkDevice							m_hDevice;
 
 		const VkCommandPool						m_hCommandPool;
 
+		DeletionQueue * const					m_pDeletionQueue;
+
 		std::set<CommandBuffer*>				m_pCommandBuffers;
+
+		std::shared_ptr<ReleasedCommandBuffers>	m_spReleasedCommandBuffers;
 		
 		const vk::CommandPoolCreateFlags		m_eUsageBehaviors;
 	};
@@ -128,7 +206,7 @@ namespace Lepton
 	private:
 
 		//!	@brief	Create command buffer object.
-		CommandBuffer(VkQueue hQueue, VkCommandBuffer hCommandBuffer);
+		CommandBuffer(CommandQueue * pCommandQueue, VkCommandBuffer hCommandBuffer);
 
 		//!	@brief	Destroy command buffer object.
 		~CommandBuffer() noexcept;
@@ -146,11 +224,21 @@ namespace Lepton
 		{
 			VkCommandBufferBeginInfo BeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, (VkFlags)eUsages, nullptr };
 
+			this->ResetBindings();
+
 			return LAVA_RESULT_CAST(vkBeginCommandBuffer(m_hCommandBuffer, &BeginInfo));
 		}
 
+		//!	@brief	Start recording a secondary command buffer that continues the subpass of the framebuffer's render pass.
+		Result BeginRecord(const Framebuffer & framebuffer, uint32_t subpass, vk::CommandBufferUsageFlags eUsages = vk::CommandBufferUsageFlagBits::eRenderPassContinue);
+
 		//!	@brief	Reset command buffer to the initial state.
-		Result Reset(VkCommandBufferResetFlags eResetFlags = 0) { return LAVA_RESULT_CAST(vkResetCommandBuffer(m_hCommandBuffer, eResetFlags)); }
+		Result Reset(VkCommandBufferResetFlags eResetFlags = 0)
+		{
+			this->ResetBindings();
+
+			return LAVA_RESULT_CAST(vkResetCommandBuffer(m_hCommandBuffer, eResetFlags));
+		}
 
 		//!	@brief	Submits a sequence of semaphores or command buffers to a queue.
 		Result Submit(VkSemaphore hWaitSemaphore, vk::PipelineStageFlags eWaitDstStageMask, VkSemaphore hSignalSemaphore, VkFence hFence = VK_NULL_HANDLE)
@@ -161,7 +249,7 @@ namespace Lepton
 			m_SubmitInfo.pSignalSemaphores		= &hSignalSemaphore;
 			m_SubmitInfo.pWaitSemaphores		= &hWaitSemaphore;
 
-			return LAVA_RESULT_CAST(vkQueueSubmit(m_hQueue, 1, &m_SubmitInfo, hFence));
+			return m_pCommandQueue->Submit(1, &m_SubmitInfo, hFence);
 		}
 
 		//!	@brief	Submits a sequence of semaphores or command buffers to a queue.
@@ -173,9 +261,12 @@ namespace Lepton
 			m_SubmitInfo.pSignalSemaphores		= nullptr;
 			m_SubmitInfo.pWaitSemaphores		= nullptr;
 
-			return LAVA_RESULT_CAST(vkQueueSubmit(m_hQueue, 1, &m_SubmitInfo, hFence));
+			return m_pCommandQueue->Submit(1, &m_SubmitInfo, hFence);
 		}
 
+		//!	@brief	Submit with any number of binary or timeline semaphore operations.
+		Result Submit(vk::ArrayProxy<const SemaphoreSubmit> pWaitSemaphores, vk::ArrayProxy<const SemaphoreSubmit> pSignalSemaphores, VkFence hFence = VK_NULL_HANDLE);
+
 	public:
 
 		//!	@brief	End the current render pass.
@@ -238,6 +329,24 @@ namespace Lepton
 			vkCmdBindPipeline(m_hCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pGraphicsPipeline->Handle());
 		}
 
+		//!	@brief	Bind a compute pipeline object to a command buffer.
+		void CmdBindPipeline(const ComputePipeline * pComputePipeline)
+		{
+			vkCmdBindPipeline(m_hCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pComputePipeline->Handle());
+		}
+
+		//!	@brief	Dispatch compute work items.
+		void CmdDispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1)
+		{
+			vkCmdDispatch(m_hCommandBuffer, groupCountX, groupCountY, groupCountZ);
+		}
+
+		//!	@brief	Dispatch compute work items with group counts read from a VkDispatchIndirectCommand in a buffer.
+		void CmdDispatchIndirect(VkBuffer hBuffer, VkDeviceSize offset = 0)
+		{
+			vkCmdDispatchIndirect(m_hCommandBuffer, hBuffer, offset);
+		}
+
 		//!	@brief	Draw primitives.
 		void CmdDraw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0, uint32_t firstInstance = 0)
 		{
@@ -262,6 +371,22 @@ namespace Lepton
 			vkCmdCopyBufferToImage(m_hCommandBuffer, hSrcBuffer, hDstImage, static_cast<VkImageLayout>(eDstImageLayout), pRegions.size(), pRegions.data());
 		}
 
+		//!	@brief	Copy data between buffer regions.
+		void CmdCopyBuffer(VkBuffer hSrcBuffer, VkBuffer hDstBuffer, vk::ArrayProxy<const VkBufferCopy> pRegions)
+		{
+			vkCmdCopyBuffer(m_hCommandBuffer, hSrcBuffer, hDstBuffer, pRegions.size(), pRegions.data());
+		}
+
+		//!	@brief	Insert buffer and image memory dependencies.
+		void CmdPipelineBarrier(vk::PipelineStageFlags srcStageMask, vk::PipelineStageFlags dstStageMask, vk::DependencyFlags dependencyFlags,
+								vk::ArrayProxy<const VkBufferMemoryBarrier> pBufferMemoryBarriers, vk::ArrayProxy<const VkImageMemoryBarrier> pImageMemoryBarriers)
+		{
+			vkCmdPipelineBarrier(m_hCommandBuffer, (VkFlags)srcStageMask, (VkFlags)dstStageMask, (VkFlags)dependencyFlags, 0, nullptr, pBufferMemoryBarriers.size(), pBufferMemoryBarriers.data(), pImageMemoryBarriers.size(), pImageMemoryBarriers.data());
+		}
+
+		//!	@brief	Execute secondary command buffers, in the given order.
+		void CmdExecuteCommands(vk::ArrayProxy<CommandBuffer* const> pCommandBuffers);
+
 		//!	@brief	Begin a new render pass.
 		void CmdBeginRenderPass(Framebuffer framebuffer, VkRect2D renderArea, vk::ArrayProxy<VkClearValue> pClearValues = {}, vk::SubpassContents eContents = vk::SubpassContents::eInline);
 
@@ -289,18 +414,135 @@ namespace Lepton
 			vkCmdBlitImage(m_hCommandBuffer, hSrcImage, static_cast<VkImageLayout>(eSrcImageLayout), hDstImage, static_cast<VkImageLayout>(eDstImageLayout), pRegions.size(), reinterpret_cast<const VkImageBlit*>(pRegions.data()), static_cast<VkFilter>(eFilter));
 		}
 
-		//!	@brief	Binds descriptor sets to a command buffer.
-		void CmdBindDescriptorSets(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, vk::ArrayProxy<VkDescriptorSet> pDescriptorSets)
+		/**
+		 *	@brief		Binds descriptor sets to set numbers firstSet onwards, skipped if it repeats the previous bind of this bind point.
+		 *	@param[in]	pDynamicOffsets - One offset per dynamic uniform/storage buffer descriptor, in set and binding order.
+		 */
+		void CmdBindDescriptorSets(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, vk::ArrayProxy<VkDescriptorSet> pDescriptorSets,
+								   uint32_t firstSet = 0, vk::ArrayProxy<const uint32_t> pDynamicOffsets = nullptr);
+
+		//!	@brief	Push descriptor writes into set of the layout (VK_KHR_push_descriptor, the set layout needs ePushDescriptorKHR), dstSet is ignored.
+		Result CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, vk::ArrayProxy<const VkWriteDescriptorSet> pWrites);
+
+		//!	@brief	Push image descriptors (sampler, combined image sampler, sampled/storage image or input attachment) to consecutive array elements of one binding.
+		Result CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, uint32_t binding, vk::DescriptorType eType, vk::ArrayProxy<const VkDescriptorImageInfo> pImageInfos);
+
+		//!	@brief	Push buffer descriptors (uniform or storage buffer) to consecutive array elements of one binding.
+		Result CmdPushDescriptorSet(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t set, uint32_t binding, vk::DescriptorType eType, vk::ArrayProxy<const VkDescriptorBufferInfo> pBufferInfos);
+
+		//!	@brief	Push a whole set from packed host data through a push template (see DescriptorUpdateTemplate).
+		Result CmdPushDescriptorSet(const DescriptorUpdateTemplate & updateTemplate, const void * pData);
+
+#ifdef VK_EXT_descriptor_buffer
+		//!	@brief	Bind descriptor buffers (VK_EXT_descriptor_buffer, see DescriptorBuffer), sets bound on every bind point become invalid.
+		void CmdBindDescriptorBuffers(vk::ArrayProxy<const VkDescriptorBufferBindingInfoEXT> pBindingInfos);
+
+		//!	@brief	Point consecutive sets, starting at firstSet, at offsets inside bound descriptor buffers.
+		void CmdSetDescriptorBufferOffsets(vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t firstSet,
+										   vk::ArrayProxy<const uint32_t> pBufferIndices, vk::ArrayProxy<const VkDeviceSize> pOffsets);
+#endif
+
+	private:
+
+		//!	@brief	Forget tracked bindings, the command buffer starts with nothing bound.
+		void ResetBindings()
+		{
+			for (auto & boundSets : m_BoundDescriptorSets)
+			{
+				boundSets.hPipelineLayout = VK_NULL_HANDLE;
+
+				boundSets.firstSet = 0;
+
+				boundSets.setCount = 0;
+			}
+		}
+
+		//!	@brief	Forget tracked bindings of one bind point (e.g. a pushed set replaced one of them).
+		void ResetBindings(vk::PipelineBindPoint ePipelineBindPoint)
 		{
-			vkCmdBindDescriptorSets(m_hCommandBuffer, static_cast<VkPipelineBindPoint>(ePipelineBindPoint), hPipelineLayout, 0, pDescriptorSets.size(), pDescriptorSets.data(), 0, nullptr);
+			const uint32_t bindPoint = static_cast<uint32_t>(ePipelineBindPoint);
+
+			if (bindPoint < 2)
+			{
+				m_BoundDescriptorSets[bindPoint].hPipelineLayout = VK_NULL_HANDLE;
+			}
 		}
 
+		static constexpr uint32_t		MaxTrackedSets = 8;
+
+		/**
+		 *	@brief	Descriptor sets last bound at one bind point (graphics or compute).
+		 */
+		struct BoundDescriptorSets
+		{
+			VkPipelineLayout			hPipelineLayout;
+			uint32_t					firstSet;
+			uint32_t					setCount;
+			VkDescriptorSet				hDescriptorSets[MaxTrackedSets];
+		};
+
 	private:
 
-		const VkQueue					m_hQueue;
+		CommandQueue * const			m_pCommandQueue;
 
 		const VkCommandBuffer			m_hCommandBuffer;
 
 		VkSubmitInfo					m_SubmitInfo;
+
+		BoundDescriptorSets				m_BoundDescriptorSets[2];
+	};
+
+	/*********************************************************************
+	*************************    SubmitBatch    **************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Collects command buffers from any number of threads and submits them with a single vkQueueSubmit.
+	 */
+	class SubmitBatch
+	{
+		LAVA_NONCOPYABLE(SubmitBatch)
+
+	public:
+
+		//!	@brief	Create submit batch for the given queue.
+		explicit SubmitBatch(CommandQueue * pCommandQueue);
+
+		//!	@brief	Destroy submit batch object (pending entries are dropped).
+		~SubmitBatch();
+
+	public:
+
+		//!	@brief	Append command buffers with their semaphore operations, executed in the order added (thread safe).
+		void Add(vk::ArrayProxy<CommandBuffer* const> pCommandBuffers, vk::ArrayProxy<const SemaphoreSubmit> pWaitSemaphores = {}, vk::ArrayProxy<const SemaphoreSubmit> pSignalSemaphores = {});
+
+		//!	@brief	Submit everything collected so far, hFence signals when all of it has completed.
+		Result Flush(VkFence hFence = VK_NULL_HANDLE);
+
+		//!	@brief	Return the number of command buffers waiting to be flushed.
+		size_t CommandBufferCount() const;
+
+	private:
+
+		/**
+		 *	@brief	Storage of one VkSubmitInfo.
+		 */
+		struct Entry
+		{
+			std::vector<VkCommandBuffer>			hCommandBuffers;
+			std::vector<VkSemaphore>				hWaitSemaphores;
+			std::vector<VkPipelineStageFlags>		eWaitDstStageMasks;
+			std::vector<uint64_t>					WaitValues;
+			std::vector<VkSemaphore>				hSignalSemaphores;
+			std::vector<uint64_t>					SignalValues;
+		};
+
+	private:
+
+		mutable std::mutex				m_Mutex;
+
+		CommandQueue * const			m_pCommandQueue;
+
+		std::vector<Entry>				m_Entries;
 	};
 }
\ No newline at end of file
@@ -3,23 +3,81 @@
 *************************************************************************/
 
 #include "ComputePipeline.h"
+#include "LogicalDevice.h"
+#include "PipelineCache.h"
 
 using namespace Lepton;
 
 /*************************************************************************
 *************************    ComputePipeline    **************************
 *************************************************************************/
-ComputePipeline::UniqueHandle::UniqueHandle(VkDevice hDevice, VkPipeline hPipeline)
-	: m_hDevice(hDevice), m_hPipeline(hPipeline)
+ComputePipeline::ComputePipeline() : m_hDevice(VK_NULL_HANDLE), m_hComputePipeline(VK_NULL_HANDLE)
 {
 
 }
 
 
-ComputePipeline::UniqueHandle::~UniqueHandle() noexcept
+ComputePipeline::ComputePipeline(const LogicalDevice * pLogicalDevice, const ComputePipelineParam & Param) : ComputePipeline()
 {
-	if (m_hPipeline != VK_NULL_HANDLE)
+	this->Create(pLogicalDevice, Param);
+}
+
+
+Result ComputePipeline::Create(const LogicalDevice * pLogicalDevice, const ComputePipelineParam & Param)
+{
+	if (pLogicalDevice == nullptr)				return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())				return Result::eErrorInvalidDeviceHandle;
+	if (!Param.pipelineLayout.IsValid())		return Result::eErrorInvalidPipelineLayoutHandle;
+	if (!Param.shaderStage.IsValid())			return Result::eErrorInvalidSPIRVCode;
+
+	if (Param.shaderStage.GetStageInfo().stage != VK_SHADER_STAGE_COMPUTE_BIT)			return Result::eErrorInvalidSPIRVCode;
+	if (Param.pipelineLayout.GetDeviceHandle() != pLogicalDevice->Handle())			return Result::eErrorInvalidDeviceHandle;
+	if (Param.shaderStage.GetDeviceHandle() != pLogicalDevice->Handle())			return Result::eErrorInvalidDeviceHandle;
+
+	VkComputePipelineCreateInfo				CreateInfo = {};
+	CreateInfo.sType						= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	CreateInfo.pNext						= nullptr;
+	CreateInfo.flags						= static_cast<VkPipelineCreateFlags>(Param.flags);
+	CreateInfo.stage						= Param.shaderStage.GetStageInfo();
+	CreateInfo.layout						= Param.pipelineLayout;
+	CreateInfo.basePipelineHandle			= VK_NULL_HANDLE;
+	CreateInfo.basePipelineIndex			= 0;
+
+	VkPipeline hPipeline = VK_NULL_HANDLE;
+
+	VkResult eResult = vkCreateComputePipelines(pLogicalDevice->Handle(), pLogicalDevice->GetPipelineCache()->Handle(), 1, &CreateInfo, nullptr, &hPipeline);
+
+	if (eResult == VK_SUCCESS)
+	{
+		this->Destroy();
+
+		m_hDevice = pLogicalDevice->Handle();
+
+		m_hComputePipeline = hPipeline;
+
+		m_Parameter = Param;
+	}
+
+	return LAVA_RESULT_CAST(eResult);
+}
+
+
+void ComputePipeline::Destroy()
+{
+	if (m_hComputePipeline != VK_NULL_HANDLE)
 	{
-		vkDestroyPipeline(m_hDevice, m_hPipeline, nullptr);
+		vkDestroyPipeline(m_hDevice, m_hComputePipeline, nullptr);
+
+		m_Parameter = ComputePipelineParam();
+
+		m_hComputePipeline = VK_NULL_HANDLE;
+
+		m_hDevice = VK_NULL_HANDLE;
 	}
+}
+
+
+ComputePipeline::~ComputePipeline()
+{
+	this->Destroy();
 }
\ No newline at end of file
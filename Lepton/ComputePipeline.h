@@ -3,10 +3,27 @@
 *************************************************************************/
 #pragma once
 
-#include "Vulkan.h"
+#include "ShaderModule.h"
+#include "PipelineLayout.h"
 
 namespace Lepton
 {
+	typedef VkPipeline		VkComputePipeline;
+
+	/*********************************************************************
+	*********************    ComputePipelineParam    *********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Vulkan compute pipeline parameters.
+	 */
+	struct ComputePipelineParam
+	{
+		vk::PipelineCreateFlags	flags;
+		PipelineLayout			pipelineLayout;
+		ShaderModule			shaderStage;
+	};
+
 	/*********************************************************************
 	***********************    ComputePipeline    ************************
 	*********************************************************************/
@@ -16,34 +33,32 @@ namespace Lepton
 	 */
 	class ComputePipeline
 	{
+		LAVA_UNIQUE_RESOURCE(ComputePipeline)
 
 	public:
 
+		//!	@brief	Create compute pipeline object.
+		ComputePipeline();
 
+		//!	@brief	Create and initialize immediately.
+		explicit ComputePipeline(const LogicalDevice * pLogicalDevice, const ComputePipelineParam & Param);
 
-	public:
-
-		/**
-		 *	@brief	Unique handle of compute pipeline.
-		 */
-		struct UniqueHandle
-		{
-			LAVA_NONCOPYABLE(UniqueHandle)
+		//!	@brief	Destroy compute pipeline object.
+		~ComputePipeline();
 
-		public:
+	public:
 
-			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(VkDevice, VkPipeline);
+		//!	@brief	Create a new compute pipeline through the pipeline cache of the device.
+		Result Create(const LogicalDevice * pLogicalDevice, const ComputePipelineParam & Param);
 
-			//!	@brief	Where resource will be released.
-			~UniqueHandle() noexcept;
+		//!	@brief	Return pipeline parameters.
+		const ComputePipelineParam & GetParam() const { return m_Parameter; }
 
-		public:
+		//!	@brief	Destroy the compute pipeline.
+		void Destroy();
 
-			const VkDevice					m_hDevice;
-			const VkPipeline				m_hPipeline;
-		};
+	private:
 
-		std::shared_ptr<UniqueHandle>		m_spHandle;
+		ComputePipelineParam		m_Parameter;
 	};
 }
\ No newline at end of file
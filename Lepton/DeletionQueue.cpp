@@ -0,0 +1,210 @@
+/*************************************************************************
+***********************    Lepton_DeletionQueue    ***********************
+*************************************************************************/
+
+#include "Commands.h"
+#include "DeletionQueue.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+**************************    DeletionQueue    ***************************
+*************************************************************************/
+DeletionQueue::DeletionQueue(VkDevice hDevice, std::vector<CommandQueue*> pCommandQueues) : m_hDevice(hDevice), m_pCommandQueues(std::move(pCommandQueues))
+{
+
+}
+
+
+void DeletionQueue::Enqueue(std::function<void()> pfnDeleter)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_CurrentDeleters.push_back(std::move(pfnDeleter));
+}
+
+
+VkFence DeletionQueue::AcquireFence()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_hFreeFences.empty())
+		{
+			VkFence hFence = m_hFreeFences.back();
+
+			m_hFreeFences.pop_back();
+
+			return hFence;
+		}
+	}
+
+	VkFenceCreateInfo			CreateInfo = {};
+	CreateInfo.sType			= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	CreateInfo.pNext			= nullptr;
+	CreateInfo.flags			= 0;
+
+	VkFence hFence = VK_NULL_HANDLE;
+
+	vkCreateFence(m_hDevice, &CreateInfo, nullptr, &hFence);
+
+	return hFence;
+}
+
+
+void DeletionQueue::Advance()
+{
+	//	Serialized, so a queue without new work is always covered by a fence of an earlier epoch.
+	std::lock_guard<std::mutex> advanceLock(m_AdvanceMutex);
+
+	Epoch epoch;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_CurrentDeleters.empty())		return;
+
+		epoch.pfnDeleters = std::move(m_CurrentDeleters);
+
+		m_CurrentDeleters.clear();
+	}
+
+	//	Caller fences may be reset or destroyed at any time, so epochs use fences of their own.
+	for (auto pCommandQueue : m_pCommandQueues)
+	{
+		VkFence hFence = this->AcquireFence();
+
+		if (pCommandQueue->SubmitEpochFence(hFence))
+		{
+			epoch.hFences.push_back(hFence);
+		}
+		else if (hFence != VK_NULL_HANDLE)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			m_hFreeFences.push_back(hFence);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_Epochs.push_back(std::move(epoch));
+}
+
+
+bool DeletionQueue::IsComplete(const Epoch & epoch) const
+{
+	for (auto hFence : epoch.hFences)
+	{
+		if (vkGetFenceStatus(m_hDevice, hFence) != VK_SUCCESS)		return false;
+	}
+
+	return true;
+}
+
+
+void DeletionQueue::Collect()
+{
+	std::vector<std::function<void()>> pfnDeleters;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		//	Epochs complete in order, stop at the first one still in flight.
+		while (!m_Epochs.empty() && this->IsComplete(m_Epochs.front()))
+		{
+			Epoch & epoch = m_Epochs.front();
+
+			for (auto & pfnDeleter : epoch.pfnDeleters)
+			{
+				pfnDeleters.push_back(std::move(pfnDeleter));
+			}
+
+			if (!epoch.hFences.empty())
+			{
+				vkResetFences(m_hDevice, static_cast<uint32_t>(epoch.hFences.size()), epoch.hFences.data());
+
+				m_hFreeFences.insert(m_hFreeFences.end(), epoch.hFences.begin(), epoch.hFences.end());
+			}
+
+			m_Epochs.pop_front();
+		}
+	}
+
+	//	Run outside the lock, deleters may release objects that enqueue again.
+	for (auto & pfnDeleter : pfnDeleters)
+	{
+		pfnDeleter();
+	}
+}
+
+
+void DeletionQueue::Flush()
+{
+	std::vector<std::function<void()>> pfnDeleters;
+
+	do
+	{
+		pfnDeleters.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (auto & epoch : m_Epochs)
+			{
+				for (auto & pfnDeleter : epoch.pfnDeleters)
+				{
+					pfnDeleters.push_back(std::move(pfnDeleter));
+				}
+
+				if (!epoch.hFences.empty())
+				{
+					vkResetFences(m_hDevice, static_cast<uint32_t>(epoch.hFences.size()), epoch.hFences.data());
+
+					m_hFreeFences.insert(m_hFreeFences.end(), epoch.hFences.begin(), epoch.hFences.end());
+				}
+			}
+
+			for (auto & pfnDeleter : m_CurrentDeleters)
+			{
+				pfnDeleters.push_back(std::move(pfnDeleter));
+			}
+
+			m_Epochs.clear();
+
+			m_CurrentDeleters.clear();
+		}
+
+		for (auto & pfnDeleter : pfnDeleters)
+		{
+			pfnDeleter();
+		}
+
+	} while (!pfnDeleters.empty());
+}
+
+
+size_t DeletionQueue::PendingCount() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	size_t pendingCount = m_CurrentDeleters.size();
+
+	for (auto & epoch : m_Epochs)
+	{
+		pendingCount += epoch.pfnDeleters.size();
+	}
+
+	return pendingCount;
+}
+
+
+DeletionQueue::~DeletionQueue()
+{
+	this->Flush();
+
+	for (auto hFence : m_hFreeFences)
+	{
+		vkDestroyFence(m_hDevice, hFence, nullptr);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*************************************************************************
+***********************    Lepton_DeletionQueue    ***********************
+*************************************************************************/
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include "Vulkan.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	************************    DeletionQueue    *************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Defers destruction of Vulkan objects until the device is provably done with them.
+	 *	@note	Every CommandQueue submission closes the current epoch behind a fence on each queue with work since the
+	 *			previous epoch, and runs the deleters of completed epochs on the submitting thread. Command buffer frees
+	 *			are handed back to their pool, which performs them on its owner thread.
+	 */
+	class DeletionQueue
+	{
+		LAVA_NONCOPYABLE(DeletionQueue)
+
+	public:
+
+		//!	@brief	Create deletion queue object covering all queues of the device.
+		explicit DeletionQueue(VkDevice hDevice, std::vector<CommandQueue*> pCommandQueues);
+
+		//!	@brief	Destroy deletion queue object (device must be idle).
+		~DeletionQueue();
+
+	public:
+
+		//!	@brief	Defer a deleter to the end of the current epoch (thread safe).
+		void Enqueue(std::function<void()> pfnDeleter);
+
+		//!	@brief	Close the current epoch behind all work submitted so far (thread safe, called by CommandQueue::Submit).
+		void Advance();
+
+		//!	@brief	Run deleters of epochs whose fences have signaled (thread safe, called by CommandQueue::Submit).
+		void Collect();
+
+		//!	@brief	Run all deleters (device must be idle).
+		void Flush();
+
+		//!	@brief	Return the number of deleters waiting for the device.
+		size_t PendingCount() const;
+
+	private:
+
+		/**
+		 *	@brief	Deleters released once all fences of the epoch have signaled.
+		 */
+		struct Epoch
+		{
+			std::vector<VkFence>					hFences;
+			std::vector<std::function<void()>>		pfnDeleters;
+		};
+
+	private:
+
+		//!	@brief	If the device is done with the epoch.
+		bool IsComplete(const Epoch & epoch) const;
+
+		//!	@brief	Return an unsignaled fence, recycled if possible (VK_NULL_HANDLE on failure).
+		VkFence AcquireFence();
+
+	private:
+
+		mutable std::mutex							m_Mutex;
+
+		std::mutex									m_AdvanceMutex;
+
+		const VkDevice								m_hDevice;
+
+		const std::vector<CommandQueue*>			m_pCommandQueues;
+
+		std::deque<Epoch>							m_Epochs;
+
+		std::vector<VkFence>						m_hFreeFences;
+
+		std::vector<std::function<void()>>			m_CurrentDeleters;
+	};
+}
\ No newline at end of file
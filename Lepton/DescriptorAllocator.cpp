@@ -0,0 +1,206 @@
+/*************************************************************************
+*******************    Lepton_DescriptorAllocator    *********************
+*************************************************************************/
+
+#include <algorithm>
+#include "DescriptorAllocator.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+***********************    DescriptorAllocator    ************************
+*************************************************************************/
+DescriptorAllocator::DescriptorAllocator()
+	: m_hDevice(VK_NULL_HANDLE), m_FrameIndex(0), m_SetsPerPool(0), m_hCurrentPool(VK_NULL_HANDLE), m_AllocatedSetCount(0)
+{
+
+}
+
+
+Result DescriptorAllocator::Create(VkDevice hDevice, uint32_t frameCount, uint32_t initialSets)
+{
+	if (hDevice == VK_NULL_HANDLE)						return Result::eErrorInvalidDeviceHandle;
+	if ((frameCount == 0) || (initialSets == 0))		return Result::eErrorInitializationFailed;
+
+	this->Destroy();
+
+	m_hDevice = hDevice;
+
+	m_SetsPerPool = std::min(initialSets, MaxSetsPerPool);
+
+	m_hFramePools.resize(frameCount);
+
+	return Result::eSuccess;
+}
+
+
+uint32_t DescriptorAllocator::BeginFrame()
+{
+	if (m_hFramePools.empty())		return 0;
+
+	m_FrameIndex = (m_FrameIndex + 1) % static_cast<uint32_t>(m_hFramePools.size());
+
+	//	Whole pools are recycled, no set is ever freed on its own.
+	for (auto hDescriptorPool : m_hFramePools[m_FrameIndex])
+	{
+		vkResetDescriptorPool(m_hDevice, hDescriptorPool, 0);
+
+		m_hFreePools.push_back(hDescriptorPool);
+	}
+
+	m_hFramePools[m_FrameIndex].clear();
+
+	m_hCurrentPool = VK_NULL_HANDLE;
+
+	return m_FrameIndex;
+}
+
+
+Result DescriptorAllocator::AcquirePool(const DescriptorSetLayout & descriptorSetLayout, bool * pIsNewPool)
+{
+	VkDescriptorPool hDescriptorPool = VK_NULL_HANDLE;
+
+	*pIsNewPool = m_hFreePools.empty();
+
+	if (!m_hFreePools.empty())
+	{
+		hDescriptorPool = m_hFreePools.back();
+
+		m_hFreePools.pop_back();
+	}
+	else
+	{
+		std::map<VkDescriptorType, uint64_t> LayoutDescriptorCounts;
+
+		for (auto & LayoutBinding : descriptorSetLayout.GetLayoutBindings())
+		{
+			LayoutDescriptorCounts[static_cast<VkDescriptorType>(LayoutBinding.descriptorType)] += LayoutBinding.descriptorCount;
+		}
+
+		//	Each descriptor type gets its share of the observed average per set, but never less than the layout needs.
+		std::vector<VkDescriptorPoolSize> PoolSizes;
+
+		for (auto & iter : m_AllocatedDescriptorCounts)
+		{
+			uint64_t descriptorCount = (iter.second * m_SetsPerPool + m_AllocatedSetCount - 1) / std::max<uint64_t>(m_AllocatedSetCount, 1);
+
+			descriptorCount = std::max(descriptorCount, LayoutDescriptorCounts[iter.first]);
+
+			descriptorCount = std::min<uint64_t>(descriptorCount, UINT32_MAX);
+
+			PoolSizes.push_back({ iter.first, static_cast<uint32_t>(std::max<uint64_t>(descriptorCount, 1)) });
+		}
+
+		VkDescriptorPoolCreateInfo		CreateInfo = {};
+		CreateInfo.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		CreateInfo.pNext				= nullptr;
+		CreateInfo.flags				= 0;
+		CreateInfo.maxSets				= m_SetsPerPool;
+		CreateInfo.poolSizeCount		= static_cast<uint32_t>(PoolSizes.size());
+		CreateInfo.pPoolSizes			= PoolSizes.data();
+
+		Result eResult = LAVA_RESULT_CAST(vkCreateDescriptorPool(m_hDevice, &CreateInfo, nullptr, &hDescriptorPool));
+
+		if (eResult != Result::eSuccess)		return eResult;
+
+		m_hDescriptorPools.push_back(hDescriptorPool);
+
+		//	Running out again means the workload is larger, grow geometrically.
+		m_SetsPerPool = std::min(m_SetsPerPool * 2, MaxSetsPerPool);
+	}
+
+	m_hFramePools[m_FrameIndex].push_back(hDescriptorPool);
+
+	m_hCurrentPool = hDescriptorPool;
+
+	return Result::eSuccess;
+}
+
+
+VkDescriptorSet DescriptorAllocator::Allocate(const DescriptorSetLayout & descriptorSetLayout)
+{
+	if (m_hDevice == VK_NULL_HANDLE)				return VK_NULL_HANDLE;
+	if (!descriptorSetLayout.IsValid())				return VK_NULL_HANDLE;
+	if (descriptorSetLayout.IsPushDescriptor())		return VK_NULL_HANDLE;
+
+	//	Update-after-bind sets need pools created with eUpdateAfterBindEXT, which are never reset under bound sets.
+	if (descriptorSetLayout.GetCreateFlags() & vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPoolEXT)		return VK_NULL_HANDLE;
+
+	for (auto eBindingFlags : descriptorSetLayout.GetBindingFlags())
+	{
+		if (eBindingFlags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)		return VK_NULL_HANDLE;
+	}
+
+	//	Usage is recorded first, so even the first pool is sized for it.
+	for (auto & LayoutBinding : descriptorSetLayout.GetLayoutBindings())
+	{
+		m_AllocatedDescriptorCounts[static_cast<VkDescriptorType>(LayoutBinding.descriptorType)] += LayoutBinding.descriptorCount;
+	}
+
+	m_AllocatedSetCount++;
+
+	VkDescriptorSetLayout				hDescriptorSetLayout = descriptorSetLayout;
+
+	VkDescriptorSetAllocateInfo			AllocateInfo = {};
+	AllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	AllocateInfo.pNext					= nullptr;
+	AllocateInfo.descriptorPool			= m_hCurrentPool;
+	AllocateInfo.descriptorSetCount		= 1;
+	AllocateInfo.pSetLayouts			= &hDescriptorSetLayout;
+
+	VkDescriptorSet hDescriptorSet = VK_NULL_HANDLE;
+
+	VkResult eResult = VK_ERROR_OUT_OF_POOL_MEMORY;
+
+	if (m_hCurrentPool != VK_NULL_HANDLE)
+	{
+		eResult = vkAllocateDescriptorSets(m_hDevice, &AllocateInfo, &hDescriptorSet);
+	}
+
+	//	Exhausted (or no) pool: chain recycled pools, a freshly created pool sized for the layout is the last attempt.
+	while ((eResult == VK_ERROR_OUT_OF_POOL_MEMORY) || (eResult == VK_ERROR_FRAGMENTED_POOL))
+	{
+		bool isNewPool = false;
+
+		if (this->AcquirePool(descriptorSetLayout, &isNewPool) != Result::eSuccess)		return VK_NULL_HANDLE;
+
+		AllocateInfo.descriptorPool = m_hCurrentPool;
+
+		eResult = vkAllocateDescriptorSets(m_hDevice, &AllocateInfo, &hDescriptorSet);
+
+		if (isNewPool)		break;
+	}
+
+	return (eResult == VK_SUCCESS) ? hDescriptorSet : VK_NULL_HANDLE;
+}
+
+
+void DescriptorAllocator::Destroy()
+{
+	for (auto hDescriptorPool : m_hDescriptorPools)
+	{
+		vkDestroyDescriptorPool(m_hDevice, hDescriptorPool, nullptr);
+	}
+
+	m_hDescriptorPools.clear();
+
+	m_hFramePools.clear();
+
+	m_hFreePools.clear();
+
+	m_AllocatedDescriptorCounts.clear();
+
+	m_hCurrentPool = VK_NULL_HANDLE;
+
+	m_hDevice = VK_NULL_HANDLE;
+
+	m_AllocatedSetCount = 0;
+
+	m_FrameIndex = 0;
+}
+
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+	this->Destroy();
+}
\ No newline at end of file
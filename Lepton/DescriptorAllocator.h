@@ -0,0 +1,77 @@
+/*************************************************************************
+*******************    Lepton_DescriptorAllocator    *********************
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include "DescriptorSet.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	*********************    DescriptorAllocator    **********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Allocates transient descriptor sets from a growing chain of pools, recycled per frame slot.
+	 *	@note	Sets are never freed individually: all pools of a slot are reset at once by BeginFrame(), call it
+	 *			only after the submissions of the slot it switches to have completed. Not thread safe, use one
+	 *			allocator per recording thread.
+	 */
+	class DescriptorAllocator
+	{
+		LAVA_NONCOPYABLE(DescriptorAllocator)
+
+	public:
+
+		//!	@brief	Create descriptor allocator object.
+		DescriptorAllocator();
+
+		//!	@brief	Destroy descriptor allocator object.
+		~DescriptorAllocator();
+
+	public:
+
+		//!	@brief	Create a new allocator cycling through frameCount slots, the first pool holds initialSets sets.
+		Result Create(VkDevice hDevice, uint32_t frameCount = 2, uint32_t initialSets = 64);
+
+		//!	@brief	Advance to the next frame slot, reset its pools and return its index.
+		uint32_t BeginFrame();
+
+		//!	@brief	Allocate a descriptor set valid until its frame slot comes around again (VK_NULL_HANDLE on failure or update-after-bind layouts).
+		VkDescriptorSet Allocate(const DescriptorSetLayout & descriptorSetLayout);
+
+		//!	@brief	Return the number of pools created so far.
+		size_t PoolCount() const { return m_hDescriptorPools.size(); }
+
+		//!	@brief	Destroy all pools, sets allocated from them become invalid.
+		void Destroy();
+
+	private:
+
+		//!	@brief	Take a recycled pool or create a new one sized from observed usage and at least one set of the layout.
+		Result AcquirePool(const DescriptorSetLayout & descriptorSetLayout, bool * pIsNewPool);
+
+	private:
+
+		static constexpr uint32_t						MaxSetsPerPool = 4096;
+
+		VkDevice										m_hDevice;
+
+		uint32_t										m_FrameIndex;
+
+		uint32_t										m_SetsPerPool;
+
+		VkDescriptorPool								m_hCurrentPool;
+
+		std::vector<VkDescriptorPool>					m_hFreePools;
+
+		std::vector<VkDescriptorPool>					m_hDescriptorPools;
+
+		std::vector<std::vector<VkDescriptorPool>>		m_hFramePools;
+
+		uint64_t										m_AllocatedSetCount;
+
+		std::map<VkDescriptorType, uint64_t>			m_AllocatedDescriptorCounts;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,329 @@
+/*************************************************************************
+*********************    Lepton_DescriptorBuffer    **********************
+*************************************************************************/
+
+#include <algorithm>
+#include "Commands.h"
+#include "Instance.h"
+#include "LogicalDevice.h"
+#include "DeletionQueue.h"
+#include "PhysicalDevice.h"
+#include "DescriptorBuffer.h"
+
+#ifdef VK_EXT_descriptor_buffer
+
+using namespace Lepton;
+
+/*************************************************************************
+*************************    DescriptorBuffer    *************************
+*************************************************************************/
+DescriptorBuffer::DescriptorBuffer()
+	: m_hDevice(VK_NULL_HANDLE), m_hBuffer(VK_NULL_HANDLE), m_hMemory(VK_NULL_HANDLE), m_pDeletionQueue(nullptr), m_pMappedData(nullptr), m_Bytes(0), m_Head(0), m_DeviceAddress(0),
+	m_Properties{}, m_IsRobustBufferAccess(false), m_pfnGetDescriptor(nullptr), m_pfnGetDescriptorSetLayoutSize(nullptr), m_pfnGetDescriptorSetLayoutBindingOffset(nullptr)
+{
+
+}
+
+
+Result DescriptorBuffer::Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (size == 0)							return Result::eErrorOutOfDeviceMemory;
+	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
+
+	const VkDevice hDevice = pLogicalDevice->Handle();
+
+	const PhysicalDevice * pPhysicalDevice = pLogicalDevice->GetPhysicalDevice();
+
+	//	Instance targets Vulkan 1.0, the properties query comes from VK_KHR_get_physical_device_properties2.
+	auto pfnGetPhysicalDeviceProperties2 = (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(pPhysicalDevice->GetInstance()->Handle(), "vkGetPhysicalDeviceProperties2KHR");
+	auto pfnGetBufferDeviceAddress = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(hDevice, "vkGetBufferDeviceAddressKHR");
+	auto pfnGetDescriptor = (PFN_vkGetDescriptorEXT)vkGetDeviceProcAddr(hDevice, "vkGetDescriptorEXT");
+	auto pfnGetDescriptorSetLayoutSize = (PFN_vkGetDescriptorSetLayoutSizeEXT)vkGetDeviceProcAddr(hDevice, "vkGetDescriptorSetLayoutSizeEXT");
+	auto pfnGetDescriptorSetLayoutBindingOffset = (PFN_vkGetDescriptorSetLayoutBindingOffsetEXT)vkGetDeviceProcAddr(hDevice, "vkGetDescriptorSetLayoutBindingOffsetEXT");
+
+	if (!pfnGetPhysicalDeviceProperties2)			return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnGetBufferDeviceAddress)					return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnGetDescriptor)							return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnGetDescriptorSetLayoutSize)				return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnGetDescriptorSetLayoutBindingOffset)	return Result::eErrorFailedToGetProcessAddress;
+
+	VkPhysicalDeviceDescriptorBufferPropertiesEXT	DescriptorBufferProperties = {};
+	DescriptorBufferProperties.sType				= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+
+	VkPhysicalDeviceProperties2KHR					Properties = {};
+	Properties.sType								= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+	Properties.pNext								= &DescriptorBufferProperties;
+
+	pfnGetPhysicalDeviceProperties2(pPhysicalDevice->Handle(), &Properties);
+
+	VkBufferCreateInfo						CreateInfo = {};
+	CreateInfo.sType						= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	CreateInfo.pNext						= nullptr;
+	CreateInfo.flags						= 0;
+	CreateInfo.size							= size;
+	CreateInfo.usage						= VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+	CreateInfo.sharingMode					= VK_SHARING_MODE_EXCLUSIVE;
+	CreateInfo.queueFamilyIndexCount		= 0;
+	CreateInfo.pQueueFamilyIndices			= nullptr;
+
+	VkBuffer hNewBuffer = VK_NULL_HANDLE;
+
+	Result eResult = LAVA_RESULT_CAST(vkCreateBuffer(hDevice, &CreateInfo, nullptr, &hNewBuffer));
+
+	if (eResult != Result::eSuccess)		return eResult;
+
+	VkMemoryRequirements Requirements = {};
+
+	vkGetBufferMemoryRequirements(hDevice, hNewBuffer, &Requirements);
+
+	//	Dedicated allocation: the sub-allocator's blocks are not created with the device address flag.
+	VkMemoryAllocateFlagsInfoKHR			AllocateFlagsInfo = {};
+	AllocateFlagsInfo.sType					= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+	AllocateFlagsInfo.pNext					= nullptr;
+	AllocateFlagsInfo.flags					= VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+	AllocateFlagsInfo.deviceMask			= 0;
+
+	VkMemoryAllocateInfo					AllocateInfo = {};
+	AllocateInfo.sType						= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	AllocateInfo.pNext						= &AllocateFlagsInfo;
+	AllocateInfo.allocationSize				= Requirements.size;
+	AllocateInfo.memoryTypeIndex			= 0;
+
+	VkDeviceMemory hNewMemory = VK_NULL_HANDLE;
+
+	void * pMappedData = nullptr;
+
+	eResult = Result::eErrorInvalidMemoryTypeBits;
+
+	//	Rewritten by the host while in use, so ranked like per-frame uploads (device-local host-visible first).
+	for (uint32_t memoryTypeIndex : pPhysicalDevice->GetMemoryTypeIndices(Requirements.memoryTypeBits, MemoryUsage::eCpuToGpu))
+	{
+		//	Descriptor writes are not flushed.
+		if (!(pPhysicalDevice->GetMemoryProperties().memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))		continue;
+
+		AllocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+		eResult = LAVA_RESULT_CAST(vkAllocateMemory(hDevice, &AllocateInfo, nullptr, &hNewMemory));
+
+		//	Heap exhausted, fall back to the next best memory type.
+		if ((eResult != Result::eErrorOutOfDeviceMemory) && (eResult != Result::eErrorOutOfHostMemory))		break;
+	}
+
+	if (eResult == Result::eSuccess)		eResult = LAVA_RESULT_CAST(vkBindBufferMemory(hDevice, hNewBuffer, hNewMemory, 0));
+
+	if (eResult == Result::eSuccess)		eResult = LAVA_RESULT_CAST(vkMapMemory(hDevice, hNewMemory, 0, VK_WHOLE_SIZE, 0, &pMappedData));
+
+	if (eResult != Result::eSuccess)
+	{
+		vkDestroyBuffer(hDevice, hNewBuffer, nullptr);
+
+		vkFreeMemory(hDevice, hNewMemory, nullptr);
+
+		return eResult;
+	}
+
+	this->Destroy();
+
+	VkBufferDeviceAddressInfoKHR			AddressInfo = {};
+	AddressInfo.sType						= VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+	AddressInfo.pNext						= nullptr;
+	AddressInfo.buffer						= hNewBuffer;
+
+	m_DeviceAddress = pfnGetBufferDeviceAddress(hDevice, &AddressInfo);
+
+	m_pDeletionQueue = pLogicalDevice->GetDeletionQueue();
+
+	m_pMappedData = static_cast<uint8_t*>(pMappedData);
+
+	m_Properties = DescriptorBufferProperties;
+
+	m_Properties.pNext = nullptr;
+
+	//	Buffer descriptors carry their bounds when robustBufferAccess is on, and are larger then.
+	m_IsRobustBufferAccess = (pLogicalDevice->GetEnabledFeatures().robustBufferAccess == VK_TRUE);
+
+	m_hMemory = hNewMemory;
+
+	m_hBuffer = hNewBuffer;
+
+	m_hDevice = hDevice;
+
+	m_Bytes = size;
+
+	m_Head = 0;
+
+	m_pfnGetDescriptor = pfnGetDescriptor;
+
+	m_pfnGetDescriptorSetLayoutSize = pfnGetDescriptorSetLayoutSize;
+
+	m_pfnGetDescriptorSetLayoutBindingOffset = pfnGetDescriptorSetLayoutBindingOffset;
+
+	return Result::eSuccess;
+}
+
+
+VkDeviceSize DescriptorBuffer::AllocateSet(const DescriptorSetLayout & descriptorSetLayout)
+{
+	if (m_hBuffer == VK_NULL_HANDLE)		return VK_WHOLE_SIZE;
+
+	VkDeviceSize layoutSize = 0;
+
+	m_pfnGetDescriptorSetLayoutSize(m_hDevice, descriptorSetLayout, &layoutSize);
+
+	const VkDeviceSize alignment = std::max<VkDeviceSize>(m_Properties.descriptorBufferOffsetAlignment, 1);
+
+	const VkDeviceSize offset = (m_Head + alignment - 1) / alignment * alignment;
+
+	if (offset + layoutSize > m_Bytes)		return VK_WHOLE_SIZE;
+
+	m_Head = offset + layoutSize;
+
+	return offset;
+}
+
+
+size_t DescriptorBuffer::GetDescriptorSize(vk::DescriptorType eType) const
+{
+	switch (eType)
+	{
+		case vk::DescriptorType::eSampler:						return m_Properties.samplerDescriptorSize;
+		case vk::DescriptorType::eCombinedImageSampler:			return m_Properties.combinedImageSamplerDescriptorSize;
+		case vk::DescriptorType::eSampledImage:					return m_Properties.sampledImageDescriptorSize;
+		case vk::DescriptorType::eStorageImage:					return m_Properties.storageImageDescriptorSize;
+		case vk::DescriptorType::eUniformTexelBuffer:			return m_IsRobustBufferAccess ? m_Properties.robustUniformTexelBufferDescriptorSize : m_Properties.uniformTexelBufferDescriptorSize;
+		case vk::DescriptorType::eStorageTexelBuffer:			return m_IsRobustBufferAccess ? m_Properties.robustStorageTexelBufferDescriptorSize : m_Properties.storageTexelBufferDescriptorSize;
+		case vk::DescriptorType::eUniformBuffer:				return m_IsRobustBufferAccess ? m_Properties.robustUniformBufferDescriptorSize : m_Properties.uniformBufferDescriptorSize;
+		case vk::DescriptorType::eStorageBuffer:				return m_IsRobustBufferAccess ? m_Properties.robustStorageBufferDescriptorSize : m_Properties.storageBufferDescriptorSize;
+		case vk::DescriptorType::eInputAttachment:				return m_Properties.inputAttachmentDescriptorSize;
+		case vk::DescriptorType::eAccelerationStructureKHR:		return m_Properties.accelerationStructureDescriptorSize;
+		default:												return 0;
+	}
+}
+
+
+void DescriptorBuffer::WriteDescriptor(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT & GetInfo)
+{
+	VkDeviceSize bindingOffset = 0;
+
+	m_pfnGetDescriptorSetLayoutBindingOffset(m_hDevice, descriptorSetLayout, binding, &bindingOffset);
+
+	const size_t descriptorSize = this->GetDescriptorSize(static_cast<vk::DescriptorType>(GetInfo.type));
+
+	//	Descriptor updates are plain writes into mapped (coherent) memory.
+	m_pfnGetDescriptor(m_hDevice, &GetInfo, descriptorSize, m_pMappedData + setOffset + bindingOffset + arrayElement * descriptorSize);
+}
+
+
+void DescriptorBuffer::WriteBuffer(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkDeviceAddress address, VkDeviceSize range)
+{
+	this->WriteTexelBuffer(setOffset, descriptorSetLayout, binding, arrayElement, eType, address, range, vk::Format::eUndefined);
+}
+
+
+void DescriptorBuffer::WriteTexelBuffer(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkDeviceAddress address, VkDeviceSize range, vk::Format eFormat)
+{
+	VkDescriptorAddressInfoEXT				AddressInfo = {};
+	AddressInfo.sType						= VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+	AddressInfo.pNext						= nullptr;
+	AddressInfo.address						= address;
+	AddressInfo.range						= range;
+	AddressInfo.format						= static_cast<VkFormat>(eFormat);
+
+	VkDescriptorGetInfoEXT					GetInfo = {};
+	GetInfo.sType							= VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+	GetInfo.pNext							= nullptr;
+	GetInfo.type							= static_cast<VkDescriptorType>(eType);
+
+	switch (eType)
+	{
+		case vk::DescriptorType::eUniformBuffer:				GetInfo.data.pUniformBuffer = &AddressInfo;				break;
+		case vk::DescriptorType::eStorageBuffer:				GetInfo.data.pStorageBuffer = &AddressInfo;				break;
+		case vk::DescriptorType::eUniformTexelBuffer:			GetInfo.data.pUniformTexelBuffer = &AddressInfo;		break;
+		case vk::DescriptorType::eStorageTexelBuffer:			GetInfo.data.pStorageTexelBuffer = &AddressInfo;		break;
+		default:												return;
+	}
+
+	this->WriteDescriptor(setOffset, descriptorSetLayout, binding, arrayElement, GetInfo);
+}
+
+
+void DescriptorBuffer::WriteImage(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkSampler hSampler, VkImageView hImageView, vk::ImageLayout eImageLayout)
+{
+	VkDescriptorImageInfo					ImageInfo = {};
+	ImageInfo.sampler						= hSampler;
+	ImageInfo.imageView						= hImageView;
+	ImageInfo.imageLayout					= static_cast<VkImageLayout>(eImageLayout);
+
+	VkDescriptorGetInfoEXT					GetInfo = {};
+	GetInfo.sType							= VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+	GetInfo.pNext							= nullptr;
+	GetInfo.type							= static_cast<VkDescriptorType>(eType);
+
+	switch (eType)
+	{
+		case vk::DescriptorType::eSampler:						GetInfo.data.pSampler = &ImageInfo.sampler;				break;
+		case vk::DescriptorType::eCombinedImageSampler:			GetInfo.data.pCombinedImageSampler = &ImageInfo;		break;
+		case vk::DescriptorType::eSampledImage:					GetInfo.data.pSampledImage = &ImageInfo;				break;
+		case vk::DescriptorType::eStorageImage:					GetInfo.data.pStorageImage = &ImageInfo;				break;
+		case vk::DescriptorType::eInputAttachment:				GetInfo.data.pInputAttachmentImage = &ImageInfo;		break;
+		default:												return;
+	}
+
+	this->WriteDescriptor(setOffset, descriptorSetLayout, binding, arrayElement, GetInfo);
+}
+
+
+void DescriptorBuffer::CmdBind(CommandBuffer * pCommandBuffer) const
+{
+	VkDescriptorBufferBindingInfoEXT		BindingInfo = {};
+	BindingInfo.sType						= VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+	BindingInfo.pNext						= nullptr;
+	BindingInfo.address						= m_DeviceAddress;
+	BindingInfo.usage						= VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+
+	pCommandBuffer->CmdBindDescriptorBuffers(BindingInfo);
+}
+
+
+void DescriptorBuffer::CmdSetOffsets(CommandBuffer * pCommandBuffer, vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t firstSet, vk::ArrayProxy<const VkDeviceSize> pSetOffsets) const
+{
+	//	Every set lives in this buffer, bound at index 0.
+	std::vector<uint32_t> BufferIndices(pSetOffsets.size(), 0);
+
+	pCommandBuffer->CmdSetDescriptorBufferOffsets(ePipelineBindPoint, hPipelineLayout, firstSet, BufferIndices, pSetOffsets);
+}
+
+
+void DescriptorBuffer::Destroy()
+{
+	if (m_hBuffer != VK_NULL_HANDLE)
+	{
+		m_pDeletionQueue->Enqueue([hDevice = m_hDevice, hBuffer = m_hBuffer, hMemory = m_hMemory]()
+		{
+			vkDestroyBuffer(hDevice, hBuffer, nullptr);
+
+			vkFreeMemory(hDevice, hMemory, nullptr);
+		});
+
+		m_hBuffer = VK_NULL_HANDLE;
+
+		m_hMemory = VK_NULL_HANDLE;
+
+		m_pMappedData = nullptr;
+
+		m_DeviceAddress = 0;
+
+		m_Bytes = 0;
+
+		m_Head = 0;
+	}
+}
+
+
+DescriptorBuffer::~DescriptorBuffer()
+{
+	this->Destroy();
+}
+
+#endif
\ No newline at end of file
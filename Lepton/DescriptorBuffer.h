@@ -0,0 +1,111 @@
+/*************************************************************************
+*********************    Lepton_DescriptorBuffer    **********************
+*************************************************************************/
+#pragma once
+
+#include "DescriptorSet.h"
+
+#ifdef VK_EXT_descriptor_buffer
+
+namespace Lepton
+{
+	/*********************************************************************
+	***********************    DescriptorBuffer    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Descriptor backend without pools or sets (VK_EXT_descriptor_buffer): descriptors are written straight into
+	 *			persistently mapped buffer memory and bound by offset.
+	 *	@note	Set layouts need vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT and pipelines
+	 *			vk::PipelineCreateFlagBits::eDescriptorBufferEXT. Requires VK_EXT_descriptor_buffer and
+	 *			VK_KHR_buffer_device_address (bufferDeviceAddress feature) on the device.
+	 */
+	class DescriptorBuffer
+	{
+		LAVA_NONCOPYABLE(DescriptorBuffer)
+
+	public:
+
+		//!	@brief	Create descriptor buffer object.
+		DescriptorBuffer();
+
+		//!	@brief	Destroy descriptor buffer object.
+		~DescriptorBuffer();
+
+	public:
+
+		//!	@brief	Return Vulkan type of this object.
+		VkBuffer Handle() const { return m_hBuffer; }
+
+		//!	@brief	If buffer handle is valid.
+		bool IsValid() const { return m_hBuffer != VK_NULL_HANDLE; }
+
+		//!	@brief	Return the device address of the buffer.
+		VkDeviceAddress GetDeviceAddress() const { return m_DeviceAddress; }
+
+		//!	@brief	Create a new host-visible descriptor buffer holding both resource and sampler descriptors.
+		Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size);
+
+		//!	@brief	Reserve space for one set of the layout and return its offset (VK_WHOLE_SIZE if the buffer is full).
+		VkDeviceSize AllocateSet(const DescriptorSetLayout & descriptorSetLayout);
+
+		//!	@brief	Release all sets at once, only after the device is done with them.
+		void Reset() { m_Head = 0; }
+
+		//!	@brief	Write a uniform or storage buffer descriptor (the buffer must have been created with device address usage).
+		void WriteBuffer(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkDeviceAddress address, VkDeviceSize range);
+
+		//!	@brief	Write a uniform or storage texel buffer descriptor.
+		void WriteTexelBuffer(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkDeviceAddress address, VkDeviceSize range, vk::Format eFormat);
+
+		//!	@brief	Write a sampler, combined image sampler, sampled/storage image or input attachment descriptor.
+		void WriteImage(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkSampler hSampler, VkImageView hImageView, vk::ImageLayout eImageLayout);
+
+		//!	@brief	Bind this buffer as buffer index 0 of the command buffer (sets bound before become invalid).
+		void CmdBind(CommandBuffer * pCommandBuffer) const;
+
+		//!	@brief	Point consecutive sets, starting at firstSet, at set offsets inside this buffer.
+		void CmdSetOffsets(CommandBuffer * pCommandBuffer, vk::PipelineBindPoint ePipelineBindPoint, VkPipelineLayout hPipelineLayout, uint32_t firstSet, vk::ArrayProxy<const VkDeviceSize> pSetOffsets) const;
+
+		//!	@brief	Destroy the buffer, the Vulkan objects are released once the device is done with them.
+		void Destroy();
+
+	private:
+
+		//!	@brief	Return the size of one descriptor of the type.
+		size_t GetDescriptorSize(vk::DescriptorType eType) const;
+
+		//!	@brief	Fetch the descriptor described by GetInfo into its place in the mapped buffer.
+		void WriteDescriptor(VkDeviceSize setOffset, const DescriptorSetLayout & descriptorSetLayout, uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT & GetInfo);
+
+	private:
+
+		VkDevice													m_hDevice;
+
+		VkBuffer													m_hBuffer;
+
+		VkDeviceMemory												m_hMemory;
+
+		DeletionQueue *												m_pDeletionQueue;
+
+		uint8_t *													m_pMappedData;
+
+		VkDeviceSize												m_Bytes;
+
+		VkDeviceSize												m_Head;
+
+		VkDeviceAddress												m_DeviceAddress;
+
+		VkPhysicalDeviceDescriptorBufferPropertiesEXT				m_Properties;
+
+		bool														m_IsRobustBufferAccess;
+
+		PFN_vkGetDescriptorEXT										m_pfnGetDescriptor;
+
+		PFN_vkGetDescriptorSetLayoutSizeEXT							m_pfnGetDescriptorSetLayoutSize;
+
+		PFN_vkGetDescriptorSetLayoutBindingOffsetEXT				m_pfnGetDescriptorSetLayoutBindingOffset;
+	};
+}
+
+#endif
\ No newline at end of file
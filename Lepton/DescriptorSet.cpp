@@ -9,17 +9,21 @@ using namespace Lepton;
 /*************************************************************************
 ***********************    DescriptorSetLayout    ************************
 *************************************************************************/
-DescriptorSetLayout::UniqueHandle::UniqueHandle(VkDevice hDevice, VkDescriptorSetLayout hDescriptorSetLayout, const std::vector<vk::DescriptorSetLayoutBinding> & LayoutBindings)
-	: m_hDevice(hDevice), m_hDescriptorSetLayout(hDescriptorSetLayout), m_LayoutBindings(LayoutBindings)
+DescriptorSetLayout::UniqueHandle::UniqueHandle(VkDevice hDevice, VkDescriptorSetLayout hDescriptorSetLayout, const std::vector<vk::DescriptorSetLayoutBinding> & LayoutBindings,
+												 vk::DescriptorSetLayoutCreateFlags eFlags, const std::vector<VkDescriptorBindingFlagsEXT> & BindingFlags)
+	: m_hDevice(hDevice), m_hDescriptorSetLayout(hDescriptorSetLayout), m_LayoutBindings(LayoutBindings), m_eFlags(eFlags), m_BindingFlags(BindingFlags)
 {
 
 }
 
 
-Result DescriptorSetLayout::Create(VkDevice hDevice, vk::ArrayProxy<vk::DescriptorSetLayoutBinding> pLayoutBindings)
+Result DescriptorSetLayout::Create(VkDevice hDevice, vk::ArrayProxy<vk::DescriptorSetLayoutBinding> pLayoutBindings, vk::DescriptorSetLayoutCreateFlags eFlags,
+								   vk::ArrayProxy<const VkDescriptorBindingFlagsEXT> pBindingFlags)
 {
 	Result eResult = Result::eErrorInvalidDeviceHandle;
 
+	if (!pBindingFlags.empty() && (pBindingFlags.size() != pLayoutBindings.size()))		return Result::eErrorInitializationFailed;
+
 	if (hDevice != VK_NULL_HANDLE)
 	{
 		std::vector<VkDescriptorSetLayoutBinding>		layoutBindings(pLayoutBindings.size());
@@ -33,10 +37,16 @@ Result DescriptorSetLayout::Create(VkDevice hDevice, vk::ArrayProxy<vk::Descript
 			layoutBindings[i].pImmutableSamplers		= nullptr;
 		}
 
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT		BindingFlagsInfo = {};
+		BindingFlagsInfo.sType								= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+		BindingFlagsInfo.pNext								= nullptr;
+		BindingFlagsInfo.bindingCount						= pBindingFlags.size();
+		BindingFlagsInfo.pBindingFlags						= pBindingFlags.data();
+
 		VkDescriptorSetLayoutCreateInfo		CreateInfo = {};
 		CreateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		CreateInfo.pNext					= nullptr;
-		CreateInfo.flags					= 0;
+		CreateInfo.pNext					= pBindingFlags.empty() ? nullptr : &BindingFlagsInfo;
+		CreateInfo.flags					= (VkFlags)eFlags;
 		CreateInfo.bindingCount				= static_cast<uint32_t>(layoutBindings.size());
 		CreateInfo.pBindings				= layoutBindings.data();
 
@@ -53,7 +63,9 @@ Result DescriptorSetLayout::Create(VkDevice hDevice, vk::ArrayProxy<vk::Descript
 				LayoutBindings[i] = *(pLayoutBindings.data() + i);
 			}
 
-			m_spUniqueHandle = std::make_shared<UniqueHandle>(hDevice, hDescriptorSetLayout, LayoutBindings);
+			std::vector<VkDescriptorBindingFlagsEXT>		BindingFlags(pBindingFlags.begin(), pBindingFlags.end());
+
+			m_spUniqueHandle = std::make_shared<UniqueHandle>(hDevice, hDescriptorSetLayout, LayoutBindings, eFlags, BindingFlags);
 		}
 	}
 
@@ -130,7 +142,7 @@ DescriptorSet * DescriptorPool::AllocateDescriptorSet(DescriptorSetLayout descri
 {
 	DescriptorSet * pDescriptorSet = nullptr;
 
-	if ((m_hDescriptorPool != nullptr) && descriptorSetLayout.IsValid())
+	if ((m_hDescriptorPool != nullptr) && descriptorSetLayout.IsValid() && !descriptorSetLayout.IsPushDescriptor())
 	{
 		VkDescriptorSetLayout				hDescriptorSetLayout = descriptorSetLayout;
 
@@ -26,12 +26,22 @@ namespace Lepton
 		//!	@brief	Whether this resource handle is valid.
 		bool IsValid() const { return m_spUniqueHandle != nullptr; }
 
-		//!	@brief	Create a new descriptor set layout object.
-		Result Create(VkDevice hDevice, vk::ArrayProxy<vk::DescriptorSetLayoutBinding> pLayoutBindings);
+		//!	@brief	Create a new descriptor set layout object, pBindingFlags (VK_EXT_descriptor_indexing) is empty or has one entry per binding.
+		Result Create(VkDevice hDevice, vk::ArrayProxy<vk::DescriptorSetLayoutBinding> pLayoutBindings, vk::DescriptorSetLayoutCreateFlags eFlags = vk::DescriptorSetLayoutCreateFlags(),
+					  vk::ArrayProxy<const VkDescriptorBindingFlagsEXT> pBindingFlags = nullptr);
 
 		//!	@brief	Return descriptor bindings.
 		const std::vector<vk::DescriptorSetLayoutBinding> & GetLayoutBindings() const { return m_spUniqueHandle->m_LayoutBindings; }
 
+		//!	@brief	Return per-binding flags (empty if none were given).
+		const std::vector<VkDescriptorBindingFlagsEXT> & GetBindingFlags() const { return m_spUniqueHandle->m_BindingFlags; }
+
+		//!	@brief	Return layout create flags.
+		vk::DescriptorSetLayoutCreateFlags GetCreateFlags() const { return m_spUniqueHandle->m_eFlags; }
+
+		//!	@brief	If created with ePushDescriptorKHR (written with CommandBuffer::CmdPushDescriptorSet(), never allocated from a pool).
+		bool IsPushDescriptor() const { return bool(m_spUniqueHandle->m_eFlags & vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR); }
+
 		//!	@brief	Return VkDevice handle.
 		VkDevice GetDeviceHandle() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDevice : VK_NULL_HANDLE; }
 
@@ -50,7 +60,7 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(VkDevice, VkDescriptorSetLayout, const std::vector<vk::DescriptorSetLayoutBinding>&);
+			UniqueHandle(VkDevice, VkDescriptorSetLayout, const std::vector<vk::DescriptorSetLayoutBinding>&, vk::DescriptorSetLayoutCreateFlags, const std::vector<VkDescriptorBindingFlagsEXT>&);
 
 			//!	@brief	Where resource will be released.
 			~UniqueHandle() noexcept;
@@ -60,6 +70,8 @@ namespace Lepton
 			const VkDevice											m_hDevice;
 			const VkDescriptorSetLayout								m_hDescriptorSetLayout;
 			const std::vector<vk::DescriptorSetLayoutBinding>		m_LayoutBindings;
+			const vk::DescriptorSetLayoutCreateFlags				m_eFlags;
+			const std::vector<VkDescriptorBindingFlagsEXT>			m_BindingFlags;
 		};
 
 		std::shared_ptr<UniqueHandle>								m_spUniqueHandle;
@@ -0,0 +1,235 @@
+/*************************************************************************
+*********************    Lepton_DescriptorWriter    **********************
+*************************************************************************/
+
+#include "DescriptorWriter.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+*************************    DescriptorWriter    *************************
+*************************************************************************/
+static constexpr uint32_t		InfoKindImage			= 0;
+static constexpr uint32_t		InfoKindBuffer			= 1;
+static constexpr uint32_t		InfoKindTexelBuffer		= 2;
+
+
+void DescriptorWriter::Append(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, uint32_t infoKind, size_t infoIndex)
+{
+	//	The infos of the last write are the tail of their array, so the next element can simply extend it.
+	if (!m_Writes.empty())
+	{
+		VkWriteDescriptorSet & LastWrite = m_Writes.back();
+
+		if ((LastWrite.dstSet == hDescriptorSet) && (LastWrite.dstBinding == binding) &&
+			(LastWrite.descriptorType == static_cast<VkDescriptorType>(eType)) &&
+			(LastWrite.dstArrayElement + LastWrite.descriptorCount == arrayElement) &&
+			(m_WriteInfos.back().infoKind == infoKind))
+		{
+			LastWrite.descriptorCount++;
+
+			return;
+		}
+	}
+
+	VkWriteDescriptorSet					DescriptorWrite = {};
+	DescriptorWrite.sType					= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	DescriptorWrite.pNext					= nullptr;
+	DescriptorWrite.dstSet					= hDescriptorSet;
+	DescriptorWrite.dstBinding				= binding;
+	DescriptorWrite.dstArrayElement			= arrayElement;
+	DescriptorWrite.descriptorCount			= 1;
+	DescriptorWrite.descriptorType			= static_cast<VkDescriptorType>(eType);
+	DescriptorWrite.pImageInfo				= nullptr;
+	DescriptorWrite.pBufferInfo				= nullptr;
+	DescriptorWrite.pTexelBufferView		= nullptr;
+
+	m_Writes.push_back(DescriptorWrite);
+
+	m_WriteInfos.push_back({ infoKind, infoIndex });
+}
+
+
+void DescriptorWriter::WriteImage(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkSampler hSampler, VkImageView hImageView, vk::ImageLayout eImageLayout)
+{
+	m_ImageInfos.push_back({ hSampler, hImageView, static_cast<VkImageLayout>(eImageLayout) });
+
+	this->Append(hDescriptorSet, binding, arrayElement, eType, InfoKindImage, m_ImageInfos.size() - 1);
+}
+
+
+void DescriptorWriter::WriteBuffer(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkBuffer hBuffer, VkDeviceSize offset, VkDeviceSize range)
+{
+	m_BufferInfos.push_back({ hBuffer, offset, range });
+
+	this->Append(hDescriptorSet, binding, arrayElement, eType, InfoKindBuffer, m_BufferInfos.size() - 1);
+}
+
+
+void DescriptorWriter::WriteTexelBuffer(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkBufferView hBufferView)
+{
+	m_TexelBufferViews.push_back(hBufferView);
+
+	this->Append(hDescriptorSet, binding, arrayElement, eType, InfoKindTexelBuffer, m_TexelBufferViews.size() - 1);
+}
+
+
+void DescriptorWriter::Flush(VkDevice hDevice)
+{
+	if (m_Writes.empty())		return;
+
+	for (size_t i = 0; i < m_Writes.size(); i++)
+	{
+		switch (m_WriteInfos[i].infoKind)
+		{
+			case InfoKindImage:				m_Writes[i].pImageInfo = &m_ImageInfos[m_WriteInfos[i].infoIndex];					break;
+			case InfoKindBuffer:			m_Writes[i].pBufferInfo = &m_BufferInfos[m_WriteInfos[i].infoIndex];				break;
+			case InfoKindTexelBuffer:		m_Writes[i].pTexelBufferView = &m_TexelBufferViews[m_WriteInfos[i].infoIndex];		break;
+		}
+	}
+
+	vkUpdateDescriptorSets(hDevice, static_cast<uint32_t>(m_Writes.size()), m_Writes.data(), 0, nullptr);
+
+	this->Clear();
+}
+
+
+void DescriptorWriter::Clear()
+{
+	m_Writes.clear();
+
+	m_WriteInfos.clear();
+
+	m_ImageInfos.clear();
+
+	m_BufferInfos.clear();
+
+	m_TexelBufferViews.clear();
+}
+
+
+/*************************************************************************
+*********************    DescriptorUpdateTemplate    *********************
+*************************************************************************/
+DescriptorUpdateTemplate::DescriptorUpdateTemplate()
+	: m_hDevice(VK_NULL_HANDLE), m_hUpdateTemplate(VK_NULL_HANDLE), m_ePipelineBindPoint(vk::PipelineBindPoint::eGraphics), m_Set(0),
+	m_pfnDestroyDescriptorUpdateTemplate(nullptr), m_pfnUpdateDescriptorSetWithTemplate(nullptr)
+{
+
+}
+
+
+Result DescriptorUpdateTemplate::Create(VkDevice hDevice, const DescriptorSetLayout & descriptorSetLayout, vk::ArrayProxy<const VkDescriptorUpdateTemplateEntryKHR> pEntries)
+{
+	if (hDevice == VK_NULL_HANDLE)									return Result::eErrorInvalidDeviceHandle;
+	if (descriptorSetLayout.GetDeviceHandle() != hDevice)			return Result::eErrorInvalidDeviceHandle;
+	if (pEntries.empty())											return Result::eErrorInitializationFailed;
+
+	VkDescriptorUpdateTemplateCreateInfoKHR		CreateInfo = {};
+	CreateInfo.sType							= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+	CreateInfo.pNext							= nullptr;
+	CreateInfo.flags							= 0;
+	CreateInfo.descriptorUpdateEntryCount		= pEntries.size();
+	CreateInfo.pDescriptorUpdateEntries			= pEntries.data();
+	CreateInfo.templateType						= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+	CreateInfo.descriptorSetLayout				= descriptorSetLayout;
+	CreateInfo.pipelineBindPoint				= VK_PIPELINE_BIND_POINT_GRAPHICS;
+	CreateInfo.pipelineLayout					= VK_NULL_HANDLE;
+	CreateInfo.set								= 0;
+
+	return this->Create(hDevice, CreateInfo);
+}
+
+
+Result DescriptorUpdateTemplate::Create(VkDevice hDevice, const PipelineLayout & pipelineLayout, vk::PipelineBindPoint ePipelineBindPoint, uint32_t set, vk::ArrayProxy<const VkDescriptorUpdateTemplateEntryKHR> pEntries)
+{
+	if (hDevice == VK_NULL_HANDLE)								return Result::eErrorInvalidDeviceHandle;
+	if (!pipelineLayout.IsValid())								return Result::eErrorInvalidPipelineLayoutHandle;
+	if (pipelineLayout.GetDeviceHandle() != hDevice)			return Result::eErrorInvalidDeviceHandle;
+	if (pEntries.empty())										return Result::eErrorInitializationFailed;
+
+	VkDescriptorUpdateTemplateCreateInfoKHR		CreateInfo = {};
+	CreateInfo.sType							= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+	CreateInfo.pNext							= nullptr;
+	CreateInfo.flags							= 0;
+	CreateInfo.descriptorUpdateEntryCount		= pEntries.size();
+	CreateInfo.pDescriptorUpdateEntries			= pEntries.data();
+	CreateInfo.templateType						= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+	CreateInfo.descriptorSetLayout				= VK_NULL_HANDLE;
+	CreateInfo.pipelineBindPoint				= static_cast<VkPipelineBindPoint>(ePipelineBindPoint);
+	CreateInfo.pipelineLayout					= pipelineLayout;
+	CreateInfo.set								= set;
+
+	Result eResult = this->Create(hDevice, CreateInfo);
+
+	if (eResult == Result::eSuccess)
+	{
+		m_PipelineLayout = pipelineLayout;
+
+		m_ePipelineBindPoint = ePipelineBindPoint;
+
+		m_Set = set;
+	}
+
+	return eResult;
+}
+
+
+Result DescriptorUpdateTemplate::Create(VkDevice hDevice, const VkDescriptorUpdateTemplateCreateInfoKHR & CreateInfo)
+{
+	PFN_vkCreateDescriptorUpdateTemplateKHR			pfnCreateDescriptorUpdateTemplate = nullptr;
+	PFN_vkDestroyDescriptorUpdateTemplateKHR		pfnDestroyDescriptorUpdateTemplate = nullptr;
+	PFN_vkUpdateDescriptorSetWithTemplateKHR		pfnUpdateDescriptorSetWithTemplate = nullptr;
+
+	pfnCreateDescriptorUpdateTemplate		= (PFN_vkCreateDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(hDevice, "vkCreateDescriptorUpdateTemplateKHR");
+	pfnDestroyDescriptorUpdateTemplate		= (PFN_vkDestroyDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(hDevice, "vkDestroyDescriptorUpdateTemplateKHR");
+	pfnUpdateDescriptorSetWithTemplate		= (PFN_vkUpdateDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(hDevice, "vkUpdateDescriptorSetWithTemplateKHR");
+
+	if (!pfnCreateDescriptorUpdateTemplate)			return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnDestroyDescriptorUpdateTemplate)		return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnUpdateDescriptorSetWithTemplate)		return Result::eErrorFailedToGetProcessAddress;
+
+	VkDescriptorUpdateTemplateKHR hUpdateTemplate = VK_NULL_HANDLE;
+
+	Result eResult = LAVA_RESULT_CAST(pfnCreateDescriptorUpdateTemplate(hDevice, &CreateInfo, nullptr, &hUpdateTemplate));
+
+	if (eResult == Result::eSuccess)
+	{
+		this->Destroy();
+
+		m_hDevice = hDevice;
+
+		m_hUpdateTemplate = hUpdateTemplate;
+
+		m_pfnDestroyDescriptorUpdateTemplate = pfnDestroyDescriptorUpdateTemplate;
+
+		m_pfnUpdateDescriptorSetWithTemplate = pfnUpdateDescriptorSetWithTemplate;
+	}
+
+	return eResult;
+}
+
+
+void DescriptorUpdateTemplate::Destroy()
+{
+	if (m_hUpdateTemplate != VK_NULL_HANDLE)
+	{
+		m_pfnDestroyDescriptorUpdateTemplate(m_hDevice, m_hUpdateTemplate, nullptr);
+
+		m_hUpdateTemplate = VK_NULL_HANDLE;
+
+		m_hDevice = VK_NULL_HANDLE;
+
+		m_PipelineLayout = PipelineLayout();
+
+		m_ePipelineBindPoint = vk::PipelineBindPoint::eGraphics;
+
+		m_Set = 0;
+	}
+}
+
+
+DescriptorUpdateTemplate::~DescriptorUpdateTemplate()
+{
+	this->Destroy();
+}
\ No newline at end of file
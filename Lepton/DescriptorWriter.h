@@ -0,0 +1,144 @@
+/*************************************************************************
+*********************    Lepton_DescriptorWriter    **********************
+*************************************************************************/
+#pragma once
+
+#include "PipelineLayout.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	***********************    DescriptorWriter    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Accumulates descriptor writes across any number of sets and applies them in one vkUpdateDescriptorSets call.
+	 *	@note	Writes to consecutive array elements of the same binding are merged into one VkWriteDescriptorSet.
+	 */
+	class DescriptorWriter
+	{
+
+	public:
+
+		//!	@brief	Queue an image write (sampler, combined image sampler, sampled/storage image or input attachment).
+		void WriteImage(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkSampler hSampler, VkImageView hImageView, vk::ImageLayout eImageLayout);
+
+		//!	@brief	Queue a buffer write (uniform or storage buffer, dynamic or not).
+		void WriteBuffer(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkBuffer hBuffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+		//!	@brief	Queue a texel buffer write (uniform or storage texel buffer).
+		void WriteTexelBuffer(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, VkBufferView hBufferView);
+
+		//!	@brief	Return the number of queued VkWriteDescriptorSet structures.
+		size_t WriteCount() const { return m_Writes.size(); }
+
+		//!	@brief	Apply all queued writes with a single call and clear the writer.
+		void Flush(VkDevice hDevice);
+
+		//!	@brief	Drop all queued writes.
+		void Clear();
+
+	private:
+
+		//!	@brief	Extend the last write if it continues it, otherwise append a new one.
+		void Append(VkDescriptorSet hDescriptorSet, uint32_t binding, uint32_t arrayElement, vk::DescriptorType eType, uint32_t infoKind, size_t infoIndex);
+
+	private:
+
+		/**
+		 *	@brief	Which info array a write points into (pointers are only resolved at flush, the arrays may grow).
+		 */
+		struct WriteInfo
+		{
+			uint32_t		infoKind;
+			size_t			infoIndex;
+		};
+
+	private:
+
+		std::vector<VkWriteDescriptorSet>		m_Writes;
+
+		std::vector<WriteInfo>					m_WriteInfos;
+
+		std::vector<VkBufferView>				m_TexelBufferViews;
+
+		std::vector<VkDescriptorImageInfo>		m_ImageInfos;
+
+		std::vector<VkDescriptorBufferInfo>		m_BufferInfos;
+	};
+
+	/*********************************************************************
+	*******************    DescriptorUpdateTemplate    *******************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Wrapper for VkDescriptorUpdateTemplateKHR, updates a whole set from a packed host structure in one call.
+	 *	@note	Requires VK_KHR_descriptor_update_template to be enabled on the device. Push templates additionally
+	 *			require VK_KHR_push_descriptor and are recorded with CommandBuffer::CmdPushDescriptorSet().
+	 */
+	class DescriptorUpdateTemplate
+	{
+		LAVA_NONCOPYABLE(DescriptorUpdateTemplate)
+
+	public:
+
+		//!	@brief	Create descriptor update template object.
+		DescriptorUpdateTemplate();
+
+		//!	@brief	Destroy descriptor update template object.
+		~DescriptorUpdateTemplate();
+
+	public:
+
+		//!	@brief	Return Vulkan type of this object.
+		VkDescriptorUpdateTemplateKHR Handle() const { return m_hUpdateTemplate; }
+
+		//!	@brief	If template handle is valid.
+		bool IsValid() const { return m_hUpdateTemplate != VK_NULL_HANDLE; }
+
+		//!	@brief	Create a new template, entry offsets and strides are byte positions in the host structure.
+		Result Create(VkDevice hDevice, const DescriptorSetLayout & descriptorSetLayout, vk::ArrayProxy<const VkDescriptorUpdateTemplateEntryKHR> pEntries);
+
+		//!	@brief	Create a new push template writing set of the pipeline layout (whose set layout needs ePushDescriptorKHR).
+		Result Create(VkDevice hDevice, const PipelineLayout & pipelineLayout, vk::PipelineBindPoint ePipelineBindPoint, uint32_t set, vk::ArrayProxy<const VkDescriptorUpdateTemplateEntryKHR> pEntries);
+
+		//!	@brief	Update all entries of the set from packed host data (not for push templates).
+		void Update(VkDescriptorSet hDescriptorSet, const void * pData) const { m_pfnUpdateDescriptorSetWithTemplate(m_hDevice, hDescriptorSet, m_hUpdateTemplate, pData); }
+
+		//!	@brief	If this template pushes descriptors instead of updating a set.
+		bool IsPushTemplate() const { return m_PipelineLayout.IsValid(); }
+
+		//!	@brief	Return the pipeline layout of a push template.
+		const PipelineLayout & GetPipelineLayout() const { return m_PipelineLayout; }
+
+		//!	@brief	Return the bind point of a push template.
+		vk::PipelineBindPoint GetPipelineBindPoint() const { return m_ePipelineBindPoint; }
+
+		//!	@brief	Return the set number written by a push template.
+		uint32_t GetSet() const { return m_Set; }
+
+		//!	@brief	Destroy the template.
+		void Destroy();
+
+	private:
+
+		//!	@brief	Load entry points and create the template.
+		Result Create(VkDevice hDevice, const VkDescriptorUpdateTemplateCreateInfoKHR & CreateInfo);
+
+	private:
+
+		VkDevice												m_hDevice;
+
+		VkDescriptorUpdateTemplateKHR							m_hUpdateTemplate;
+
+		PipelineLayout											m_PipelineLayout;
+
+		vk::PipelineBindPoint									m_ePipelineBindPoint;
+
+		uint32_t												m_Set;
+
+		PFN_vkDestroyDescriptorUpdateTemplateKHR				m_pfnDestroyDescriptorUpdateTemplate;
+
+		PFN_vkUpdateDescriptorSetWithTemplateKHR				m_pfnUpdateDescriptorSetWithTemplate;
+	};
+}
\ No newline at end of file
@@ -11,8 +11,8 @@ using namespace Lepton;
 /*************************************************************************
 ***************************    DeviceMemory    ***************************
 *************************************************************************/
-DeviceMemory::UniqueHandle::UniqueHandle(VkDevice hDevice, VkDeviceMemory hDeviceMemory, VkDeviceSize allocateSize)
-	: m_hDevice(hDevice), m_hDeviceMemory(hDeviceMemory), m_AllocateSize(allocateSize)
+DeviceMemory::UniqueHandle::UniqueHandle(VkDevice hDevice, VkDeviceMemory hDeviceMemory, VkDeviceSize allocateSize, vk::MemoryPropertyFlags eProperties)
+	: m_hDevice(hDevice), m_hDeviceMemory(hDeviceMemory), m_AllocateSize(allocateSize), m_eProperties(eProperties)
 {
 
 }
@@ -27,10 +27,35 @@ Result DeviceMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequ
 
 	if (memoryTypeIndex == LAVA_INVALID_INDEX)		return Result::eErrorInvalidMemoryTypeBits;
 
+	return this->Allocate(pLogicalDevice, memoryRequirements.size, memoryTypeIndex);
+}
+
+
+Result DeviceMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements, MemoryUsage eUsage)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
+
+	Result eResult = Result::eErrorInvalidMemoryTypeBits;
+
+	for (uint32_t memoryTypeIndex : pLogicalDevice->GetPhysicalDevice()->GetMemoryTypeIndices(memoryRequirements.memoryTypeBits, eUsage))
+	{
+		eResult = this->Allocate(pLogicalDevice, memoryRequirements.size, memoryTypeIndex);
+
+		//	Heap exhausted, fall back to the next best memory type.
+		if ((eResult != Result::eErrorOutOfDeviceMemory) && (eResult != Result::eErrorOutOfHostMemory))		break;
+	}
+
+	return eResult;
+}
+
+
+Result DeviceMemory::Allocate(const LogicalDevice * pLogicalDevice, VkDeviceSize size, uint32_t memoryTypeIndex)
+{
 	VkMemoryAllocateInfo				AllocateInfo = {};
 	AllocateInfo.sType					= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 	AllocateInfo.pNext					= nullptr;
-	AllocateInfo.allocationSize			= memoryRequirements.size;
+	AllocateInfo.allocationSize			= size;
 	AllocateInfo.memoryTypeIndex		= memoryTypeIndex;
 
 	VkDeviceMemory hDeviceMemory = VK_NULL_HANDLE;
@@ -39,7 +64,9 @@ Result DeviceMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequ
 
 	if (eResult == Result::eSuccess)
 	{
-		m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->Handle(), hDeviceMemory, AllocateInfo.allocationSize);
+		auto & MemoryType = pLogicalDevice->GetPhysicalDevice()->GetMemoryProperties().memoryTypes[memoryTypeIndex];
+
+		m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->Handle(), hDeviceMemory, AllocateInfo.allocationSize, vk::MemoryPropertyFlags(MemoryType.propertyFlags));
 	}
 
 	return eResult;
@@ -90,35 +117,34 @@ DeviceMemory::UniqueHandle::~UniqueHandle() noexcept
 /*************************************************************************
 ************************    DeviceLocalMemory    *************************
 *************************************************************************/
-DeviceLocalMemory::UniqueHandle::UniqueHandle(VkDevice hDevice, VkDeviceMemory hDeviceMemory, VkDeviceSize allocationSize)
-	: m_hDevice(hDevice), m_hDeviceMemory(hDeviceMemory), m_SizeBytes(allocationSize)
+DeviceLocalMemory::UniqueHandle::UniqueHandle(const MemoryAllocator::Allocation & allocation) : m_Allocation(allocation)
 {
 
 }
 
 
-Result DeviceLocalMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements)
+Result DeviceLocalMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements, bool isLinear, MemoryUsage eUsage)
 {
 	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
 	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
 
-	uint32_t memoryTypeIndex = pLogicalDevice->GetPhysicalDevice()->GetMemoryTypeIndex(memoryRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+	Result eResult = Result::eErrorInvalidMemoryTypeBits;
 
-	if (memoryTypeIndex == LAVA_INVALID_INDEX)		return Result::eErrorInvalidMemoryTypeBits;
+	MemoryAllocator::Allocation Allocation;
 
-	VkMemoryAllocateInfo				AllocateInfo = {};
-	AllocateInfo.sType					= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	AllocateInfo.pNext					= nullptr;
-	AllocateInfo.allocationSize			= memoryRequirements.size;
-	AllocateInfo.memoryTypeIndex		= memoryTypeIndex;
+	for (uint32_t memoryTypeIndex : pLogicalDevice->GetPhysicalDevice()->GetMemoryTypeIndices(memoryRequirements.memoryTypeBits, eUsage))
+	{
+		eResult = pLogicalDevice->GetMemoryAllocator()->Allocate(&Allocation, memoryRequirements, memoryTypeIndex, isLinear);
 
-	VkDeviceMemory hDeviceMemory = VK_NULL_HANDLE;
+		if (eResult == Result::eSuccess)
+		{
+			m_spUniqueHandle = std::make_shared<UniqueHandle>(Allocation);
 
-	Result eResult = LAVA_RESULT_CAST(vkAllocateMemory(pLogicalDevice->Handle(), &AllocateInfo, nullptr, &hDeviceMemory));
+			break;
+		}
 
-	if (eResult == Result::eSuccess)
-	{
-		m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->Handle(), hDeviceMemory, memoryRequirements.size);
+		//	Heap exhausted, fall back to the next best memory type.
+		if ((eResult != Result::eErrorOutOfDeviceMemory) && (eResult != Result::eErrorOutOfHostMemory))		break;
 	}
 
 	return eResult;
@@ -127,8 +153,8 @@ Result DeviceLocalMemory::Allocate(const LogicalDevice * pLogicalDevice, VkMemor
 
 DeviceLocalMemory::UniqueHandle::~UniqueHandle() noexcept
 {
-	if (m_hDeviceMemory != VK_NULL_HANDLE)
+	if (m_Allocation.spMemoryBlock != nullptr)
 	{
-		vkFreeMemory(m_hDevice, m_hDeviceMemory, nullptr);
+		m_Allocation.spMemoryBlock->Free(m_Allocation.offset, m_Allocation.size);
 	}
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 *************************************************************************/
 #pragma once
 
-#include "Vulkan.h"
+#include "MemoryAllocator.h"
 
 namespace Lepton
 {
@@ -40,15 +40,26 @@ namespace Lepton
 		//!	@brief	Return the size of device memory.
 		VkDeviceSize Size() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_AllocateSize : 0; }
 
+		//!	@brief	Return property flags of the memory type actually allocated from.
+		vk::MemoryPropertyFlags GetPropertyFlags() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_eProperties : vk::MemoryPropertyFlags(); }
+
 		//!	@brief	Return VkDevice handle.
 		VkDevice GetDeviceHandle() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDevice : VK_NULL_HANDLE; }
 
-		//!	@brief	Allocate device memory.
+		//!	@brief	Allocate device memory from the first type that has all the requested property bits set.
 		Result Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements, vk::MemoryPropertyFlags eProperties);
 
+		//!	@brief	Allocate device memory from the best type for the usage, falling back when a heap is exhausted.
+		Result Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements, MemoryUsage eUsage);
+
 		//!	@brief	Convert to VkDeviceMemory.
 		operator VkDeviceMemory() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDeviceMemory : VK_NULL_HANDLE; }
 
+	private:
+
+		//!	@brief	Allocate device memory from the given memory type.
+		Result Allocate(const LogicalDevice * pLogicalDevice, VkDeviceSize size, uint32_t memoryTypeIndex);
+
 	private:
 
 		/**
@@ -61,7 +72,7 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(VkDevice, VkDeviceMemory, VkDeviceSize);
+			UniqueHandle(VkDevice, VkDeviceMemory, VkDeviceSize, vk::MemoryPropertyFlags);
 
 			//!	@brief	Where resource will be released.
 			~UniqueHandle() noexcept;
@@ -71,6 +82,7 @@ namespace Lepton
 			const VkDevice					m_hDevice;
 			const VkDeviceSize				m_AllocateSize;
 			const VkDeviceMemory			m_hDeviceMemory;
+			const vk::MemoryPropertyFlags	m_eProperties;
 		};
 
 		std::shared_ptr<UniqueHandle>		m_spUniqueHandle;
@@ -81,7 +93,7 @@ namespace Lepton
 	*********************************************************************/
 
 	/**
-	 *	@brief	Wrapper for Vulkan device-local memory object.
+	 *	@brief	Wrapper for Vulkan device-local memory range (sub-allocated from a memory block).
 	 */
 	class DeviceLocalMemory
 	{
@@ -94,17 +106,20 @@ namespace Lepton
 		//!	@brief	Whether this resource handle is valid.
 		bool IsEmpty() const { return m_spUniqueHandle != nullptr; }
 
-		//!	@brief	Allocate a new device memory object.
-		Result Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements);
+		//!	@brief	Allocate a new device memory range (images must pass isLinear = false).
+		Result Allocate(const LogicalDevice * pLogicalDevice, VkMemoryRequirements memoryRequirements, bool isLinear = true, MemoryUsage eUsage = MemoryUsage::eGpuOnly);
 
 		//!	@brief	Return the size of device memory in bytes.
-		VkDeviceSize Size() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_SizeBytes : 0; }
+		VkDeviceSize Size() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_Allocation.size : 0; }
+
+		//!	@brief	Return the offset in bytes into VkDeviceMemory, resources must be bound at this offset.
+		VkDeviceSize Offset() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_Allocation.offset : 0; }
 
 		//!	@brief	Return VkDevice handle.
-		VkDevice GetDeviceHandle() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDevice : VK_NULL_HANDLE; }
+		VkDevice GetDeviceHandle() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_Allocation.spMemoryBlock->GetDeviceHandle() : VK_NULL_HANDLE; }
 
 		//!	@brief	Convert to VkDeviceMemory.
-		operator VkDeviceMemory() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDeviceMemory : VK_NULL_HANDLE; }
+		operator VkDeviceMemory() const { return (m_spUniqueHandle != nullptr) ? static_cast<VkDeviceMemory>(*m_spUniqueHandle->m_Allocation.spMemoryBlock) : VK_NULL_HANDLE; }
 
 	private:
 
@@ -117,17 +132,15 @@ namespace Lepton
 
 		public:
 
-			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(VkDevice, VkDeviceMemory, VkDeviceSize);
+			//!	@brief	Constructor (allocation must be valid).
+			explicit UniqueHandle(const MemoryAllocator::Allocation&);
 
-			//!	@brief	Where resource will be released.
+			//!	@brief	Where range will be returned to its block.
 			~UniqueHandle() noexcept;
 
 		public:
 
-			const VkDevice					m_hDevice;
-			const VkDeviceSize				m_SizeBytes;
-			const VkDeviceMemory			m_hDeviceMemory;
+			const MemoryAllocator::Allocation		m_Allocation;
 		};
 
 		std::shared_ptr<UniqueHandle>		m_spUniqueHandle;
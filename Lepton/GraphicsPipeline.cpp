@@ -2,10 +2,13 @@
 *************************    Lepton_Pipelines    *************************
 *************************************************************************/
 
+#include <cstring>
 #include "Framebuffer.h"
 #include "ShaderModule.h"
 #include "PipelineLayout.h"
 #include "GraphicsPipeline.h"
+#include "LogicalDevice.h"
+#include "PipelineCache.h"
 
 using namespace Lepton;
 
@@ -18,6 +21,113 @@ GraphicsPipelineParam::GraphicsPipelineParam() : inputAssemblyState(vk::Primitiv
 }
 
 
+//	All hashed structures are tightly packed 32-bit fields.
+template<typename Type> static void HashArray(uint64_t & hash, const std::vector<Type> & values)
+{
+	HashValue(hash, values.size());
+
+	HashBytes(hash, values.data(), sizeof(Type) * values.size());
+}
+
+
+uint64_t GraphicsPipelineParam::Hash() const
+{
+	uint64_t hash = HashSeed;
+
+	HashValue(hash, static_cast<VkRenderPass>(renderPass));
+	HashValue(hash, static_cast<VkPipelineLayout>(pipelineLayout));
+	HashValue(hash, static_cast<VkPipelineCreateFlags>(flags));
+
+	HashValue(hash, shaderStages.size());
+
+	for (auto & shaderStage : shaderStages)
+	{
+		const VkPipelineShaderStageCreateInfo StageInfo = shaderStage.GetStageInfo();
+
+		HashValue(hash, StageInfo.stage);
+		HashValue(hash, StageInfo.module);
+
+		HashBytes(hash, StageInfo.pName, std::strlen(StageInfo.pName));
+
+		if (shaderStage.GetSpecialization() != nullptr)
+		{
+			HashValue(hash, shaderStage.GetSpecialization()->Hash());
+		}
+	}
+
+	HashArray(hash, dynamicStates);
+	HashArray(hash, viewportState.scissors);
+	HashArray(hash, viewportState.viewports);
+	HashArray(hash, vertexInputState.bindingDescriptions);
+	HashArray(hash, vertexInputState.attributeDescriptions);
+
+	HashValue(hash, colorBlendState.logicOpEnable);
+	HashValue(hash, colorBlendState.logicOp);
+	HashValue(hash, colorBlendState.blendConstants);
+	HashArray(hash, colorBlendState.attachments);
+
+	HashValue(hash, multisampleState);
+	HashValue(hash, depthStencilState);
+	HashValue(hash, tessellationState);
+	HashValue(hash, inputAssemblyState);
+	HashValue(hash, rasterizationState);
+
+	return hash;
+}
+
+
+template<typename Type> static bool EqualBytes(const Type & lhs, const Type & rhs)
+{
+	return std::memcmp(&lhs, &rhs, sizeof(Type)) == 0;
+}
+
+
+template<typename Type> static bool EqualArray(const std::vector<Type> & lhs, const std::vector<Type> & rhs)
+{
+	return (lhs.size() == rhs.size()) && (lhs.empty() || (std::memcmp(lhs.data(), rhs.data(), sizeof(Type) * lhs.size()) == 0));
+}
+
+
+bool GraphicsPipelineParam::operator==(const GraphicsPipelineParam & Other) const
+{
+	if (static_cast<VkRenderPass>(renderPass) != static_cast<VkRenderPass>(Other.renderPass))							return false;
+	if (static_cast<VkPipelineLayout>(pipelineLayout) != static_cast<VkPipelineLayout>(Other.pipelineLayout))			return false;
+	if (flags != Other.flags)																							return false;
+	if (shaderStages.size() != Other.shaderStages.size())																return false;
+
+	for (size_t i = 0; i < shaderStages.size(); i++)
+	{
+		const VkPipelineShaderStageCreateInfo StageInfo = shaderStages[i].GetStageInfo();
+		const VkPipelineShaderStageCreateInfo OtherStageInfo = Other.shaderStages[i].GetStageInfo();
+
+		if (StageInfo.stage != OtherStageInfo.stage)									return false;
+		if (StageInfo.module != OtherStageInfo.module)									return false;
+		if (std::strcmp(StageInfo.pName, OtherStageInfo.pName) != 0)					return false;
+
+		const SpecializationConstants * pSpecialization = shaderStages[i].GetSpecialization();
+		const SpecializationConstants * pOtherSpecialization = Other.shaderStages[i].GetSpecialization();
+
+		if ((pSpecialization == nullptr) != (pOtherSpecialization == nullptr))			return false;
+		if ((pSpecialization != nullptr) && !(*pSpecialization == *pOtherSpecialization))	return false;
+	}
+
+	return EqualArray(dynamicStates, Other.dynamicStates) &&
+		   EqualArray(viewportState.scissors, Other.viewportState.scissors) &&
+		   EqualArray(viewportState.viewports, Other.viewportState.viewports) &&
+		   EqualArray(vertexInputState.bindingDescriptions, Other.vertexInputState.bindingDescriptions) &&
+		   EqualArray(vertexInputState.attributeDescriptions, Other.vertexInputState.attributeDescriptions) &&
+		   EqualBytes(colorBlendState.logicOpEnable, Other.colorBlendState.logicOpEnable) &&
+		   EqualBytes(colorBlendState.logicOp, Other.colorBlendState.logicOp) &&
+		   EqualBytes(colorBlendState.blendConstants, Other.colorBlendState.blendConstants) &&
+		   EqualArray(colorBlendState.attachments, Other.colorBlendState.attachments) &&
+		   EqualBytes(multisampleState, Other.multisampleState) &&
+		   EqualBytes(depthStencilState, Other.depthStencilState) &&
+		   EqualBytes(tessellationState, Other.tessellationState) &&
+		   EqualBytes(inputAssemblyState, Other.inputAssemblyState) &&
+		   EqualBytes(rasterizationState, Other.rasterizationState);
+}
+
+
 void GraphicsPipelineParam::VertexInputStateInfo::SetLocation(uint32_t Location, uint32_t Binding, vk::Format eFormat, uint32_t Offset)
 {
 	for (size_t i = 0; i < attributeDescriptions.size(); i++)
@@ -56,6 +166,21 @@ void GraphicsPipelineParam::VertexInputStateInfo::SetBinding(uint32_t Binding, u
 }
 
 
+void GraphicsPipelineParam::VertexInputStateInfo::SetFromShader(const ShaderModule & vertexShader, uint32_t Binding, vk::VertexInputRate eInputRate)
+{
+	uint32_t stride = 0;
+
+	for (auto & Input : vertexShader.GetReflection().GetVertexInputs())
+	{
+		this->SetLocation(Input.location, Binding, Input.eFormat, stride);
+
+		stride += Input.size;
+	}
+
+	this->SetBinding(Binding, stride, eInputRate);
+}
+
+
 /*************************************************************************
 *************************    GraphicsPipeline    *************************
 *************************************************************************/
@@ -65,16 +190,20 @@ GraphicsPipeline::GraphicsPipeline() : m_hDevice(VK_NULL_HANDLE), m_hGraphicsPip
 }
 
 
-GraphicsPipeline::GraphicsPipeline(const GraphicsPipelineParam & Param) : GraphicsPipeline()
+GraphicsPipeline::GraphicsPipeline(const LogicalDevice * pLogicalDevice, const GraphicsPipelineParam & Param) : GraphicsPipeline()
 {
-	this->Create(Param);
+	this->Create(pLogicalDevice, Param);
 }
 
 
-Result GraphicsPipeline::Create(const GraphicsPipelineParam & Param)
+Result GraphicsPipeline::Create(const LogicalDevice * pLogicalDevice, const GraphicsPipelineParam & Param)
 {
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
+
 	if (!Param.renderPass.IsValid() || !Param.pipelineLayout.IsValid() ||
-		 Param.renderPass.GetDeviceHandle() != Param.pipelineLayout.GetDeviceHandle())
+		 Param.renderPass.GetDeviceHandle() != Param.pipelineLayout.GetDeviceHandle() ||
+		 Param.renderPass.GetDeviceHandle() != pLogicalDevice->Handle())
 	{
 		return Result::eErrorInvalidDeviceHandle;
 	}
@@ -192,7 +321,7 @@ Result GraphicsPipeline::Create(const GraphicsPipelineParam & Param)
 	VkGraphicsPipelineCreateInfo									PipelineCreateInfo = {};
 	PipelineCreateInfo.sType										= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 	PipelineCreateInfo.pNext										= nullptr;
-	PipelineCreateInfo.flags										= 0;
+	PipelineCreateInfo.flags										= static_cast<VkPipelineCreateFlags>(Param.flags);
 	PipelineCreateInfo.stageCount									= static_cast<uint32_t>(ShaderStageCreateInfos.size());
 	PipelineCreateInfo.pStages										= ShaderStageCreateInfos.data();
 	PipelineCreateInfo.pVertexInputState							= &VertexInputStateCreateInfo;
@@ -212,13 +341,13 @@ Result GraphicsPipeline::Create(const GraphicsPipelineParam & Param)
 
 	VkPipeline hPipeline = VK_NULL_HANDLE;
 
-	VkResult eResult = vkCreateGraphicsPipelines(Param.renderPass.GetDeviceHandle(), VK_NULL_HANDLE, 1, &PipelineCreateInfo, nullptr, &hPipeline);
+	VkResult eResult = vkCreateGraphicsPipelines(pLogicalDevice->Handle(), pLogicalDevice->GetPipelineCache()->Handle(), 1, &PipelineCreateInfo, nullptr, &hPipeline);
 
 	if (eResult == VK_SUCCESS)
 	{
 		this->Destroy();
 
-		m_hDevice = Param.renderPass.GetDeviceHandle();
+		m_hDevice = pLogicalDevice->Handle();
 
 		m_hGraphicsPipeline = hPipeline;
 
@@ -247,4 +376,108 @@ void GraphicsPipeline::Destroy()
 GraphicsPipeline::~GraphicsPipeline()
 {
 	this->Destroy();
+}
+
+
+/*************************************************************************
+**********************    GraphicsPipelineCache    ***********************
+*************************************************************************/
+GraphicsPipelineCache::GraphicsPipelineCache(const LogicalDevice * pLogicalDevice) : m_pLogicalDevice(pLogicalDevice)
+{
+
+}
+
+
+std::shared_ptr<GraphicsPipeline> GraphicsPipelineCache::GetOrCreate(const GraphicsPipelineParam & Param, Result * pResult)
+{
+	const uint64_t hash = Param.Hash();
+
+	std::promise<Creation> Promise;
+
+	std::shared_future<Creation> Future;
+
+	const Entry * pEntry = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto range = m_Pipelines.equal_range(hash);
+
+		for (auto iter = range.first; iter != range.second; iter++)
+		{
+			if (iter->second.Param == Param)
+			{
+				Future = iter->second.Future;
+
+				break;
+			}
+		}
+
+		if (!Future.valid())
+		{
+			pEntry = &m_Pipelines.emplace(hash, Entry{ Param, Promise.get_future().share() })->second;
+		}
+	}
+
+	if (Future.valid())
+	{
+		//	Hit, possibly still being compiled by another thread.
+		const Creation & creation = Future.get();
+
+		if (pResult != nullptr)		*pResult = creation.eResult;
+
+		return creation.spPipeline;
+	}
+
+	auto spPipeline = std::make_shared<GraphicsPipeline>();
+
+	Result eResult = spPipeline->Create(m_pLogicalDevice, Param);
+
+	if (eResult != Result::eSuccess)
+	{
+		spPipeline = nullptr;
+
+		//	Failures are not cached, a later call may succeed.
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto range = m_Pipelines.equal_range(hash);
+
+		for (auto iter = range.first; iter != range.second; iter++)
+		{
+			if (&iter->second == pEntry)
+			{
+				m_Pipelines.erase(iter);
+
+				break;
+			}
+		}
+	}
+
+	Promise.set_value(Creation{ spPipeline, eResult });
+
+	if (pResult != nullptr)		*pResult = eResult;
+
+	return spPipeline;
+}
+
+
+size_t GraphicsPipelineCache::Size() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return m_Pipelines.size();
+}
+
+
+void GraphicsPipelineCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_Pipelines.clear();
+}
+
+
+GraphicsPipelineCache::~GraphicsPipelineCache()
+{
+
 }
\ No newline at end of file
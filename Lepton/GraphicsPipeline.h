@@ -3,6 +3,9 @@
 *************************************************************************/
 #pragma once
 
+#include <mutex>
+#include <future>
+#include <unordered_map>
 #include "Framebuffer.h"
 #include "ShaderModule.h"
 #include "PipelineLayout.h"
@@ -26,6 +29,12 @@ namespace Lepton
 		//!	@brief	Constructor.
 		GraphicsPipelineParam();
 
+		//!	@brief	Return 64-bit hash of all states, shaders (with specialization constants), render pass and layout (stable for the lifetime of the referenced objects).
+		uint64_t Hash() const;
+
+		//!	@brief	If all states hashed by Hash() are equal, used to resolve hash collisions.
+		bool operator==(const GraphicsPipelineParam & Other) const;
+
 	private:
 
 		//!	@brief	Parameter of a newly created pipeline tessellation state.
@@ -174,6 +183,7 @@ namespace Lepton
 		class VertexInputStateInfo
 		{
 			friend class GraphicsPipeline;
+			friend struct GraphicsPipelineParam;
 
 		public:
 
@@ -183,6 +193,9 @@ namespace Lepton
 			//!	@brief	Specify vertex input binding.
 			void SetBinding(uint32_t binding, uint32_t stride, vk::VertexInputRate eInputRate = vk::VertexInputRate::eVertex);
 
+			//!	@brief	Specify all reflected inputs of the vertex shader, tightly packed in location order into one binding.
+			void SetFromShader(const ShaderModule & vertexShader, uint32_t binding = 0, vk::VertexInputRate eInputRate = vk::VertexInputRate::eVertex);
+
 		private:
 
 			std::vector<VkVertexInputBindingDescription>		bindingDescriptions;
@@ -192,6 +205,7 @@ namespace Lepton
 	public:
 
 		RenderPass							renderPass;
+		vk::PipelineCreateFlags				flags;
 		PipelineLayout						pipelineLayout;
 
 		ShaderStagesInfo					shaderStages;
@@ -223,15 +237,15 @@ namespace Lepton
 		GraphicsPipeline();
 
 		//!	@brief	Create and initialize immediately.
-		explicit GraphicsPipeline(const GraphicsPipelineParam & Param);
+		explicit GraphicsPipeline(const LogicalDevice * pLogicalDevice, const GraphicsPipelineParam & Param);
 
 		//!	@brief	Destroy graphics pipeline object.
 		~GraphicsPipeline();
 
 	public:
 
-		//!	@brief	Create a new graphics pipeline.
-		Result Create(const GraphicsPipelineParam & Param);
+		//!	@brief	Create a new graphics pipeline through the pipeline cache of the device.
+		Result Create(const LogicalDevice * pLogicalDevice, const GraphicsPipelineParam & Param);
 
 		//!	@brief	Return pipeline parameters.
 		const GraphicsPipelineParam & GetParam() const { return m_Parameter; }
@@ -243,4 +257,64 @@ namespace Lepton
 
 		GraphicsPipelineParam		m_Parameter;
 	};
+
+	/*********************************************************************
+	*********************    GraphicsPipelineCache    ********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Shares graphics pipelines between callers with identical parameters, keyed by GraphicsPipelineParam::Hash().
+	 *	@note	Parameters are compared on a hash hit, so colliding hashes never share a pipeline.
+	 */
+	class GraphicsPipelineCache
+	{
+		LAVA_NONCOPYABLE(GraphicsPipelineCache)
+
+	public:
+
+		//!	@brief	Create graphics pipeline cache for the device.
+		explicit GraphicsPipelineCache(const LogicalDevice * pLogicalDevice);
+
+		//!	@brief	Destroy graphics pipeline cache object.
+		~GraphicsPipelineCache();
+
+	public:
+
+		//!	@brief	Return the shared pipeline for Param, creating it on a miss (thread safe, nullptr on failure).
+		std::shared_ptr<GraphicsPipeline> GetOrCreate(const GraphicsPipelineParam & Param, Result * pResult = nullptr);
+
+		//!	@brief	Return the number of cached pipelines.
+		size_t Size() const;
+
+		//!	@brief	Drop all cached references, pipelines still held by callers stay alive.
+		void Clear();
+
+	private:
+
+		/**
+		 *	@brief	Outcome of one pipeline creation, shared with callers waiting on it.
+		 */
+		struct Creation
+		{
+			std::shared_ptr<GraphicsPipeline>		spPipeline;
+			Result									eResult;
+		};
+
+		/**
+		 *	@brief	Parameters of a cached pipeline and its (possibly pending) creation.
+		 */
+		struct Entry
+		{
+			GraphicsPipelineParam					Param;
+			std::shared_future<Creation>			Future;
+		};
+
+	private:
+
+		mutable std::mutex										m_Mutex;
+
+		const LogicalDevice * const								m_pLogicalDevice;
+
+		std::unordered_multimap<uint64_t, Entry>				m_Pipelines;
+	};
 }
\ No newline at end of file
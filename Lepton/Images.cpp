@@ -4,6 +4,7 @@
 
 #include "Images.h"
 #include "LogicalDevice.h"
+#include "DeletionQueue.h"
 
 using namespace Lepton;
 
@@ -19,8 +20,8 @@ template class BaseImage<VK_IMAGE_TYPE_2D, VK_IMAGE_VIEW_TYPE_CUBE_ARRAY>;
 ****************************    BaseImage    *****************************
 *************************************************************************/
 template<VkImageType eImageType, VkImageViewType eViewType> BaseImage<eImageType, eViewType>::
-UniqueHandle::UniqueHandle(DeviceLocalMemory deviceMemory, VkImage hImage, VkImageView hImageView, const ImageParam & Param)
-	: m_DeviceMemory(deviceMemory), m_hImage(hImage), m_hImageView(hImageView), m_Parameter(Param)
+UniqueHandle::UniqueHandle(DeletionQueue * pDeletionQueue, DeviceLocalMemory deviceMemory, VkImage hImage, VkImageView hImageView, const ImageParam & Param)
+	: m_pDeletionQueue(pDeletionQueue), m_DeviceMemory(deviceMemory), m_hImage(hImage), m_hImageView(hImageView), m_Parameter(Param)
 {
 
 }
@@ -65,11 +66,13 @@ Result BaseImage<eImageType, eViewType>::Create(const LogicalDevice * pLogicalDe
 
 		vkGetImageMemoryRequirements(pLogicalDevice->Handle(), hImage, &Requirements);
 
-		eResult = deviceMemory.Allocate(pLogicalDevice, Requirements);
+		MemoryUsage eMemoryUsage = (eUsages & vk::ImageUsageFlagBits::eTransientAttachment) ? MemoryUsage::eGpuLazy : MemoryUsage::eGpuOnly;
+
+		eResult = deviceMemory.Allocate(pLogicalDevice, Requirements, false, eMemoryUsage);
 
 		if (eResult == Result::eSuccess)
 		{
-			eResult = LAVA_RESULT_CAST(vkBindImageMemory(pLogicalDevice->Handle(), hImage, deviceMemory, 0));
+			eResult = LAVA_RESULT_CAST(vkBindImageMemory(pLogicalDevice->Handle(), hImage, deviceMemory, deviceMemory.Offset()));
 
 			if (eResult == Result::eSuccess)
 			{
@@ -105,7 +108,7 @@ Result BaseImage<eImageType, eViewType>::Create(const LogicalDevice * pLogicalDe
 					imageParam.usage			= eUsages;
 					imageParam.aspectMask		= eAspects;
 
-					m_spUniqueHandle = std::make_shared<UniqueHandle>(deviceMemory, hImage, hImageView, imageParam);
+					m_spUniqueHandle = std::make_shared<UniqueHandle>(pLogicalDevice->GetDeletionQueue(), deviceMemory, hImage, hImageView, imageParam);
 
 					return Result::eSuccess;
 				}
@@ -123,8 +126,16 @@ template<VkImageType eImageType, VkImageViewType eViewType> BaseImage<eImageType
 {
 	if (m_hImage != VK_NULL_HANDLE)
 	{
-		vkDestroyImageView(m_DeviceMemory.GetDeviceHandle(), m_hImageView, nullptr);
+		VkImage hImage = m_hImage;
+
+		VkImageView hImageView = m_hImageView;
+
+		//	Memory is captured as well, so that the range is not reused before the image is gone.
+		m_pDeletionQueue->Enqueue([hImage, hImageView, deviceMemory = m_DeviceMemory]()
+		{
+			vkDestroyImageView(deviceMemory.GetDeviceHandle(), hImageView, nullptr);
 
-		vkDestroyImage(m_DeviceMemory.GetDeviceHandle(), m_hImage, nullptr);
+			vkDestroyImage(deviceMemory.GetDeviceHandle(), hImage, nullptr);
+		});
 	}
 }
\ No newline at end of file
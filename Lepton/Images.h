@@ -70,13 +70,14 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(DeviceLocalMemory, VkImage, VkImageView, const ImageParam&);
+			UniqueHandle(DeletionQueue*, DeviceLocalMemory, VkImage, VkImageView, const ImageParam&);
 
-			//!	@brief	Where resource will be released.
+			//!	@brief	Where resource will be queued for release.
 			~UniqueHandle() noexcept;
 
 		public:
 
+			DeletionQueue * const			m_pDeletionQueue;
 			const VkImage					m_hImage;
 			const ImageParam				m_Parameter;
 			const VkImageView				m_hImageView;
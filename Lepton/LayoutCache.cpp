@@ -0,0 +1,208 @@
+/*************************************************************************
+***********************    Lepton_LayoutCache    *************************
+*************************************************************************/
+
+#include <algorithm>
+#include "LayoutCache.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+***************************    LayoutCache    ****************************
+*************************************************************************/
+LayoutCache::LayoutCache(VkDevice hDevice) : m_hDevice(hDevice)
+{
+
+}
+
+
+uint64_t LayoutCache::HashBindings(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings)
+{
+	uint64_t hash = HashSeed;
+
+	HashValue(hash, pLayoutBindings.size());
+
+	//	Binding numbers are implied by position (see DescriptorSetLayout::Create), so they are not hashed.
+	for (uint32_t i = 0; i < pLayoutBindings.size(); i++)
+	{
+		const vk::DescriptorSetLayoutBinding & LayoutBinding = *(pLayoutBindings.data() + i);
+
+		HashValue(hash, static_cast<uint64_t>(LayoutBinding.descriptorType));
+
+		HashValue(hash, LayoutBinding.descriptorCount);
+
+		HashValue(hash, static_cast<VkFlags>(LayoutBinding.stageFlags));
+	}
+
+	return hash;
+}
+
+
+bool LayoutCache::DescriptorSetLayoutKey::operator==(const DescriptorSetLayoutKey & Other) const
+{
+	//	Same fields as HashBindings(), binding numbers are implied by position.
+	return std::equal(layoutBindings.begin(), layoutBindings.end(), Other.layoutBindings.begin(), Other.layoutBindings.end(),
+					  [](const vk::DescriptorSetLayoutBinding & a, const vk::DescriptorSetLayoutBinding & b)
+	{
+		return (a.descriptorType == b.descriptorType) && (a.descriptorCount == b.descriptorCount) && (a.stageFlags == b.stageFlags);
+	});
+}
+
+
+bool LayoutCache::PipelineLayoutKey::operator==(const PipelineLayoutKey & Other) const
+{
+	return (descriptorSetLayouts == Other.descriptorSetLayouts) && (pushConstantRanges == Other.pushConstantRanges);
+}
+
+
+DescriptorSetLayout LayoutCache::GetDescriptorSetLayoutLocked(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings, Result * pResult)
+{
+	DescriptorSetLayoutKey Key = { HashBindings(pLayoutBindings), std::vector<vk::DescriptorSetLayoutBinding>(pLayoutBindings.begin(), pLayoutBindings.end()) };
+
+	auto iter = m_DescriptorSetLayouts.find(Key);
+
+	if (iter != m_DescriptorSetLayouts.end())
+	{
+		if (pResult != nullptr)		*pResult = Result::eSuccess;
+
+		return iter->second;
+	}
+
+	DescriptorSetLayout descriptorSetLayout;
+
+	Result eResult = descriptorSetLayout.Create(m_hDevice, Key.layoutBindings);
+
+	if (eResult == Result::eSuccess)
+	{
+		m_DescriptorSetLayouts.emplace(std::move(Key), descriptorSetLayout);
+	}
+
+	if (pResult != nullptr)		*pResult = eResult;
+
+	return descriptorSetLayout;
+}
+
+
+DescriptorSetLayout LayoutCache::GetDescriptorSetLayout(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings, Result * pResult)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return this->GetDescriptorSetLayoutLocked(pLayoutBindings, pResult);
+}
+
+
+PipelineLayout LayoutCache::GetPipelineLayout(vk::ArrayProxy<const DescriptorSetLayout> pDescriptorSetLayouts, vk::ArrayProxy<const vk::PushConstantRange> pPushConstantRanges, Result * pResult)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	Result eResult = Result::eSuccess;
+
+	uint64_t hash = HashSeed;
+
+	std::vector<DescriptorSetLayout> DescriptorSetLayouts(pDescriptorSetLayouts.size());
+
+	std::vector<VkDescriptorSetLayout> hDescriptorSetLayouts(pDescriptorSetLayouts.size());
+
+	for (uint32_t i = 0; i < pDescriptorSetLayouts.size(); i++)
+	{
+		const DescriptorSetLayout & descriptorSetLayout = *(pDescriptorSetLayouts.data() + i);
+
+		if (!descriptorSetLayout.IsValid())
+		{
+			if (pResult != nullptr)		*pResult = Result::eErrorInitializationFailed;
+
+			return PipelineLayout();
+		}
+
+		//	Equivalent set layouts created elsewhere are replaced by the interned handle, layouts with flags are kept as they are.
+		if (descriptorSetLayout.GetCreateFlags() || !descriptorSetLayout.GetBindingFlags().empty())
+		{
+			DescriptorSetLayouts[i] = descriptorSetLayout;
+		}
+		else
+		{
+			DescriptorSetLayouts[i] = this->GetDescriptorSetLayoutLocked(descriptorSetLayout.GetLayoutBindings(), &eResult);
+		}
+
+		if (eResult != Result::eSuccess)
+		{
+			if (pResult != nullptr)		*pResult = eResult;
+
+			return PipelineLayout();
+		}
+
+		hDescriptorSetLayouts[i] = DescriptorSetLayouts[i];
+
+		HashValue(hash, reinterpret_cast<uint64_t>(hDescriptorSetLayouts[i]));
+	}
+
+	//	Range order carries no meaning, sort it out of the key.
+	std::vector<vk::PushConstantRange> PushConstantRanges(pPushConstantRanges.begin(), pPushConstantRanges.end());
+
+	std::sort(PushConstantRanges.begin(), PushConstantRanges.end(), [](const vk::PushConstantRange & a, const vk::PushConstantRange & b)
+	{
+		if (a.offset != b.offset)		return a.offset < b.offset;
+		if (a.size != b.size)			return a.size < b.size;
+
+		return static_cast<VkFlags>(a.stageFlags) < static_cast<VkFlags>(b.stageFlags);
+	});
+
+	HashValue(hash, DescriptorSetLayouts.size());
+
+	for (auto & PushConstantRange : PushConstantRanges)
+	{
+		HashValue(hash, PushConstantRange.offset);
+
+		HashValue(hash, PushConstantRange.size);
+
+		HashValue(hash, static_cast<VkFlags>(PushConstantRange.stageFlags));
+	}
+
+	PipelineLayoutKey Key = { hash, std::move(hDescriptorSetLayouts), std::move(PushConstantRanges) };
+
+	auto iter = m_PipelineLayouts.find(Key);
+
+	if (iter != m_PipelineLayouts.end())
+	{
+		if (pResult != nullptr)		*pResult = Result::eSuccess;
+
+		return iter->second;
+	}
+
+	PipelineLayout pipelineLayout;
+
+	eResult = pipelineLayout.Create(m_hDevice, DescriptorSetLayouts, Key.pushConstantRanges);
+
+	if (eResult == Result::eSuccess)
+	{
+		m_PipelineLayouts.emplace(std::move(Key), pipelineLayout);
+	}
+
+	if (pResult != nullptr)		*pResult = eResult;
+
+	return pipelineLayout;
+}
+
+
+size_t LayoutCache::Size() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return m_DescriptorSetLayouts.size() + m_PipelineLayouts.size();
+}
+
+
+void LayoutCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_PipelineLayouts.clear();
+
+	m_DescriptorSetLayouts.clear();
+}
+
+
+LayoutCache::~LayoutCache()
+{
+	this->Clear();
+}
\ No newline at end of file
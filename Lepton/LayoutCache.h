@@ -0,0 +1,98 @@
+/*************************************************************************
+***********************    Lepton_LayoutCache    *************************
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include "PipelineLayout.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	*************************    LayoutCache    **************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Interns descriptor set layouts and pipeline layouts, so identical definitions share one handle.
+	 *	@note	Sharing handles keeps layouts trivially compatible, descriptor sets stay bound across pipelines
+	 *			created from the same layout.
+	 */
+	class LayoutCache
+	{
+		LAVA_NONCOPYABLE(LayoutCache)
+
+	public:
+
+		//!	@brief	Create layout cache for the device.
+		explicit LayoutCache(VkDevice hDevice);
+
+		//!	@brief	Destroy layout cache object.
+		~LayoutCache();
+
+	public:
+
+		//!	@brief	Return the shared descriptor set layout for the bindings (binding numbers are array indices, thread safe).
+		DescriptorSetLayout GetDescriptorSetLayout(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings, Result * pResult = nullptr);
+
+		//!	@brief	Return the shared pipeline layout, set layouts are interned by their bindings (thread safe).
+		PipelineLayout GetPipelineLayout(vk::ArrayProxy<const DescriptorSetLayout> pDescriptorSetLayouts, vk::ArrayProxy<const vk::PushConstantRange> pPushConstantRanges = nullptr, Result * pResult = nullptr);
+
+		//!	@brief	Return the number of cached layouts (both kinds).
+		size_t Size() const;
+
+		//!	@brief	Drop all cached references, layouts still held by callers stay alive.
+		void Clear();
+
+	private:
+
+		//!	@brief	Canonical hash of layout bindings.
+		static uint64_t HashBindings(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings);
+
+		//!	@brief	Create or return the interned layout, m_Mutex must be held.
+		DescriptorSetLayout GetDescriptorSetLayoutLocked(vk::ArrayProxy<const vk::DescriptorSetLayoutBinding> pLayoutBindings, Result * pResult);
+
+	private:
+
+		/**
+		 *	@brief	Canonical descriptor set layout definition, compared on hash hits.
+		 */
+		struct DescriptorSetLayoutKey
+		{
+			uint64_t										hash;
+			std::vector<vk::DescriptorSetLayoutBinding>		layoutBindings;
+
+			bool operator==(const DescriptorSetLayoutKey & Other) const;
+		};
+
+		/**
+		 *	@brief	Canonical pipeline layout definition (interned set layouts, sorted ranges), compared on hash hits.
+		 */
+		struct PipelineLayoutKey
+		{
+			uint64_t										hash;
+			std::vector<VkDescriptorSetLayout>				descriptorSetLayouts;
+			std::vector<vk::PushConstantRange>				pushConstantRanges;
+
+			bool operator==(const PipelineLayoutKey & Other) const;
+		};
+
+		/**
+		 *	@brief	Buckets keys by their precomputed hash.
+		 */
+		struct KeyHasher
+		{
+			template<typename KeyType> size_t operator()(const KeyType & Key) const { return static_cast<size_t>(Key.hash); }
+		};
+
+	private:
+
+		mutable std::mutex																	m_Mutex;
+
+		const VkDevice																		m_hDevice;
+
+		std::unordered_map<DescriptorSetLayoutKey, DescriptorSetLayout, KeyHasher>			m_DescriptorSetLayouts;
+
+		std::unordered_map<PipelineLayoutKey, PipelineLayout, KeyHasher>					m_PipelineLayouts;
+	};
+}
\ No newline at end of file
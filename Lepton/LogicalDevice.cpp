@@ -6,19 +6,23 @@
 #include "Commands.h"
 #include "LogicalDevice.h"
 #include "PhysicalDevice.h"
+#include "DeletionQueue.h"
+#include "LayoutCache.h"
+#include "PipelineCache.h"
+#include "MemoryAllocator.h"
 
 using namespace Lepton;
 
 /*************************************************************************
 **************************    LogicalDevice    ***************************
 *************************************************************************/
-LogicalDevice::LogicalDevice(PhysicalDevice * pPhysicalDevice) : m_pPhysicalDevice(pPhysicalDevice)
+LogicalDevice::LogicalDevice(PhysicalDevice * pPhysicalDevice) : m_hDevice(VK_NULL_HANDLE), m_pPhysicalDevice(pPhysicalDevice), m_pMemoryAllocator(nullptr), m_pDeletionQueue(nullptr), m_pPipelineCache(nullptr), m_pLayoutCache(nullptr), m_EnabledFeatures{}
 {
 	m_PerFamilQueues.resize(m_pPhysicalDevice->GetQueueFamilies().size());
 }
 
 
-Result LogicalDevice::StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures)
+Result LogicalDevice::StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures, const void * pNext)
 {
 	if (m_hDevice != VK_NULL_HANDLE)				return Result::eSuccess;
 
@@ -52,7 +56,7 @@ Result LogicalDevice::StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures)
 
 	VkDeviceCreateInfo								DeviceCreateInfo = {};
 	DeviceCreateInfo.sType							= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-	DeviceCreateInfo.pNext							= nullptr;
+	DeviceCreateInfo.pNext							= pNext;
 	DeviceCreateInfo.flags							= 0;
 	DeviceCreateInfo.queueCreateInfoCount			= static_cast<uint32_t>(QueueCreateInfos.size());
 	DeviceCreateInfo.pQueueCreateInfos				= QueueCreateInfos.data();
@@ -68,6 +72,39 @@ Result LogicalDevice::StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures)
 
 	if (eResult == VK_SUCCESS)
 	{
+		//	Created first, a failure leaves nothing else to unwind but the device.
+		PipelineCache * pPipelineCache = new PipelineCache();
+
+		Result eCacheResult = pPipelineCache->Create(hDevice, m_pPhysicalDevice->GetProperties());
+
+		if (eCacheResult != Result::eSuccess)
+		{
+			delete pPipelineCache;
+
+			vkDestroyDevice(hDevice, nullptr);
+
+			return eCacheResult;
+		}
+
+		std::vector<CommandQueue*> pCommandQueues;
+
+		for (auto & pQueues : m_PerFamilQueues)
+		{
+			pCommandQueues.insert(pCommandQueues.end(), pQueues.begin(), pQueues.end());
+		}
+
+		m_pDeletionQueue = new DeletionQueue(hDevice, pCommandQueues);
+
+		//	Null unless VK_KHR_push_descriptor was enabled.
+		auto pfnCmdPushDescriptorSet = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(hDevice, "vkCmdPushDescriptorSetKHR");
+		auto pfnCmdPushDescriptorSetWithTemplate = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(hDevice, "vkCmdPushDescriptorSetWithTemplateKHR");
+
+#ifdef VK_EXT_descriptor_buffer
+		//	Null unless VK_EXT_descriptor_buffer was enabled.
+		auto pfnCmdBindDescriptorBuffers = (PFN_vkCmdBindDescriptorBuffersEXT)vkGetDeviceProcAddr(hDevice, "vkCmdBindDescriptorBuffersEXT");
+		auto pfnCmdSetDescriptorBufferOffsets = (PFN_vkCmdSetDescriptorBufferOffsetsEXT)vkGetDeviceProcAddr(hDevice, "vkCmdSetDescriptorBufferOffsetsEXT");
+#endif
+
 		for (uint32_t familyIndex = 0; familyIndex < m_PerFamilQueues.size(); familyIndex++)
 		{
 			for (uint32_t queueIndex = 0; queueIndex < m_PerFamilQueues[familyIndex].size(); queueIndex++)
@@ -75,10 +112,42 @@ Result LogicalDevice::StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures)
 				vkGetDeviceQueue(hDevice, familyIndex, queueIndex, &m_PerFamilQueues[familyIndex][queueIndex]->m_hQueue);
 
 				m_PerFamilQueues[familyIndex][queueIndex]->m_hDevice = hDevice;
+
+				m_PerFamilQueues[familyIndex][queueIndex]->m_pDeletionQueue = m_pDeletionQueue;
+
+				m_PerFamilQueues[familyIndex][queueIndex]->m_pfnCmdPushDescriptorSet = pfnCmdPushDescriptorSet;
+
+				m_PerFamilQueues[familyIndex][queueIndex]->m_pfnCmdPushDescriptorSetWithTemplate = pfnCmdPushDescriptorSetWithTemplate;
+
+#ifdef VK_EXT_descriptor_buffer
+				m_PerFamilQueues[familyIndex][queueIndex]->m_pfnCmdBindDescriptorBuffers = pfnCmdBindDescriptorBuffers;
+
+				m_PerFamilQueues[familyIndex][queueIndex]->m_pfnCmdSetDescriptorBufferOffsets = pfnCmdSetDescriptorBufferOffsets;
+#endif
 			}
 		}
 
 		m_hDevice = hDevice;
+
+		//	Features may also come through a chained VkPhysicalDeviceFeatures2 (then pEnabledFeatures must be null).
+		for (auto pChain = static_cast<const VkBaseInStructure*>(pNext); pChain != nullptr; pChain = pChain->pNext)
+		{
+			if (pChain->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2)
+			{
+				m_EnabledFeatures = reinterpret_cast<const VkPhysicalDeviceFeatures2*>(pChain)->features;
+			}
+		}
+
+		if (pEnabledFeatures != nullptr)
+		{
+			m_EnabledFeatures = *pEnabledFeatures;
+		}
+
+		m_pMemoryAllocator = new MemoryAllocator(this);
+
+		m_pPipelineCache = pPipelineCache;
+
+		m_pLayoutCache = new LayoutCache(hDevice);
 	}
 
 	return LAVA_RESULT_CAST(eResult);
@@ -154,6 +223,15 @@ LogicalDevice::~LogicalDevice() noexcept
 
 		this->WaitIdle();
 
+		//	Deleters may still hold memory ranges, release them before the allocator.
+		delete m_pDeletionQueue;
+
+		delete m_pMemoryAllocator;
+
+		delete m_pPipelineCache;
+
+		delete m_pLayoutCache;
+
 		vkDestroyDevice(m_hDevice, nullptr);
 	}
 }
\ No newline at end of file
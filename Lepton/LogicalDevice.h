@@ -38,9 +38,25 @@ namespace Lepton
 		//!	@brief	Wait for a device to become idle.
 		Result WaitIdle() { return LAVA_RESULT_CAST(vkDeviceWaitIdle(m_hDevice)); }
 
+		//!	@brief	Return the device memory sub-allocator (valid after start up).
+		MemoryAllocator * GetMemoryAllocator() const { return m_pMemoryAllocator; }
+
+		//!	@brief	Return the deferred destruction queue (valid after start up).
+		DeletionQueue * GetDeletionQueue() const { return m_pDeletionQueue; }
+
+		//!	@brief	Return the pipeline cache used by every pipeline creation (valid after start up).
+		PipelineCache * GetPipelineCache() const { return m_pPipelineCache; }
+
+		//!	@brief	Return the cache interning descriptor set and pipeline layouts (valid after start up).
+		LayoutCache * GetLayoutCache() const { return m_pLayoutCache; }
+
+		//!	@brief	Return the core features enabled at start up (from pEnabledFeatures or a chained VkPhysicalDeviceFeatures2).
+		const VkPhysicalDeviceFeatures & GetEnabledFeatures() const { return m_EnabledFeatures; }
+
 		CommandQueue * PreInstallQueue(uint32_t familyIndex, float priority = 0.0f);
 
-		Result StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures = nullptr);
+		//!	@brief	Create the device, pNext may chain extension feature structures (e.g. VkPhysicalDeviceTimelineSemaphoreFeaturesKHR).
+		Result StartUp(const VkPhysicalDeviceFeatures * pEnabledFeatures = nullptr, const void * pNext = nullptr);
 
 		const PhysicalDevice * GetPhysicalDevice() const { return m_pPhysicalDevice; }
 		
@@ -60,6 +76,16 @@ namespace Lepton
 
 		PhysicalDevice * const						m_pPhysicalDevice;
 
+		MemoryAllocator *							m_pMemoryAllocator;
+
+		DeletionQueue *								m_pDeletionQueue;
+
+		PipelineCache *								m_pPipelineCache;
+
+		LayoutCache *								m_pLayoutCache;
+
+		VkPhysicalDeviceFeatures					m_EnabledFeatures;
+
 		std::vector<std::vector<CommandQueue*>>		m_PerFamilQueues;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,276 @@
+/*************************************************************************
+**********************    Lepton_MemoryAllocator    **********************
+*************************************************************************/
+
+#include <algorithm>
+#include "LogicalDevice.h"
+#include "PhysicalDevice.h"
+#include "MemoryAllocator.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+***************************    MemoryBlock    ****************************
+*************************************************************************/
+MemoryBlock::MemoryBlock(VkDevice hDevice, VkDeviceMemory hDeviceMemory, VkDeviceSize size, uint32_t memoryTypeIndex)
+	: m_hDevice(hDevice), m_Size(size), m_hDeviceMemory(hDeviceMemory), m_MemoryTypeIndex(memoryTypeIndex)
+{
+	this->InsertFreeRange(0, size);
+}
+
+
+VkDeviceSize MemoryBlock::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	alignment = std::max<VkDeviceSize>(alignment, 1);
+
+	//	Best fit: walk free ranges from the smallest one that could hold the request.
+	for (auto iter = m_FreeSizes.lower_bound(size); iter != m_FreeSizes.end(); iter++)
+	{
+		const VkDeviceSize rangeSize = iter->first;
+		const VkDeviceSize rangeOffset = iter->second;
+		const VkDeviceSize alignedOffset = (rangeOffset + alignment - 1) / alignment * alignment;
+
+		if (alignedOffset + size <= rangeOffset + rangeSize)
+		{
+			this->EraseFreeRange(m_FreeRanges.find(rangeOffset));
+
+			if (alignedOffset > rangeOffset)
+			{
+				this->InsertFreeRange(rangeOffset, alignedOffset - rangeOffset);
+			}
+
+			if (alignedOffset + size < rangeOffset + rangeSize)
+			{
+				this->InsertFreeRange(alignedOffset + size, rangeOffset + rangeSize - alignedOffset - size);
+			}
+
+			return alignedOffset;
+		}
+	}
+
+	return VK_WHOLE_SIZE;
+}
+
+
+void MemoryBlock::Free(VkDeviceSize offset, VkDeviceSize size)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	auto next = m_FreeRanges.lower_bound(offset);
+
+	//	Merge with the following free range.
+	if ((next != m_FreeRanges.end()) && (offset + size == next->first))
+	{
+		size += next->second;
+
+		this->EraseFreeRange(next);
+	}
+
+	auto prev = m_FreeRanges.lower_bound(offset);
+
+	//	Merge with the preceding free range.
+	if (prev != m_FreeRanges.begin())
+	{
+		--prev;
+
+		if (prev->first + prev->second == offset)
+		{
+			offset = prev->first;
+
+			size += prev->second;
+
+			this->EraseFreeRange(prev);
+		}
+	}
+
+	this->InsertFreeRange(offset, size);
+}
+
+
+void MemoryBlock::InsertFreeRange(VkDeviceSize offset, VkDeviceSize size)
+{
+	m_FreeRanges.emplace(offset, size);
+
+	m_FreeSizes.emplace(size, offset);
+}
+
+
+void MemoryBlock::EraseFreeRange(std::map<VkDeviceSize, VkDeviceSize>::iterator iter)
+{
+	auto range = m_FreeSizes.equal_range(iter->second);
+
+	for (auto it = range.first; it != range.second; it++)
+	{
+		if (it->second == iter->first)
+		{
+			m_FreeSizes.erase(it);
+
+			break;
+		}
+	}
+
+	m_FreeRanges.erase(iter);
+}
+
+
+MemoryBlock::~MemoryBlock() noexcept
+{
+	if (m_hDeviceMemory != VK_NULL_HANDLE)
+	{
+		vkFreeMemory(m_hDevice, m_hDeviceMemory, nullptr);
+	}
+}
+
+
+/*************************************************************************
+*************************    MemoryAllocator    **************************
+*************************************************************************/
+MemoryAllocator::MemoryAllocator(const LogicalDevice * pLogicalDevice, VkDeviceSize blockSize)
+	: m_hDevice(pLogicalDevice->Handle()), m_BlockSize(blockSize), m_pPhysicalDevice(pLogicalDevice->GetPhysicalDevice())
+{
+
+}
+
+
+VkDeviceSize MemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const
+{
+	auto & MemoryProperties = m_pPhysicalDevice->GetMemoryProperties();
+
+	VkDeviceSize heapSize = MemoryProperties.memoryHeaps[MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+
+	//	Small heaps (e.g. 256MB BAR) must not be eaten by a few blocks.
+	return std::min(m_BlockSize, heapSize / 8);
+}
+
+
+Result MemoryAllocator::CreateBlock(std::shared_ptr<MemoryBlock> * pMemoryBlock, VkDeviceSize size, uint32_t memoryTypeIndex)
+{
+	VkMemoryAllocateInfo				AllocateInfo = {};
+	AllocateInfo.sType					= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	AllocateInfo.pNext					= nullptr;
+	AllocateInfo.allocationSize			= size;
+	AllocateInfo.memoryTypeIndex		= memoryTypeIndex;
+
+	VkDeviceMemory hDeviceMemory = VK_NULL_HANDLE;
+
+	Result eResult = LAVA_RESULT_CAST(vkAllocateMemory(m_hDevice, &AllocateInfo, nullptr, &hDeviceMemory));
+
+	if (eResult == Result::eSuccess)
+	{
+		*pMemoryBlock = std::make_shared<MemoryBlock>(m_hDevice, hDeviceMemory, size, memoryTypeIndex);
+	}
+
+	return eResult;
+}
+
+
+Result MemoryAllocator::Allocate(Allocation * pAllocation, VkMemoryRequirements memoryRequirements, uint32_t memoryTypeIndex, bool isLinear)
+{
+	if (memoryTypeIndex >= m_pPhysicalDevice->GetMemoryProperties().memoryTypeCount)		return Result::eErrorInvalidMemoryTypeBits;
+	if ((memoryRequirements.memoryTypeBits & (1u << memoryTypeIndex)) == 0)					return Result::eErrorInvalidMemoryTypeBits;
+
+	const VkDeviceSize blockSize = this->GetBlockSize(memoryTypeIndex);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	auto & MemoryBlocks = m_MemoryBlocks[memoryTypeIndex][isLinear ? 0 : 1];
+
+	//	Large resources get a dedicated block, which is released together with the resource.
+	const bool isDedicated = memoryRequirements.size > blockSize / 2;
+
+	if (!isDedicated)
+	{
+		bool hasEmptyBlock = false;
+
+		for (size_t i = 0; i < MemoryBlocks.size();)
+		{
+			std::shared_ptr<MemoryBlock> & spMemoryBlock = MemoryBlocks[i];
+
+			//	Referenced by the list only, so it is empty (ranges are only handed out under the lock).
+			//	One empty block is kept so that short-lived resources don't reallocate it every frame.
+			if (spMemoryBlock.use_count() == 1)
+			{
+				if (hasEmptyBlock)
+				{
+					spMemoryBlock = std::move(MemoryBlocks.back());
+
+					MemoryBlocks.pop_back();
+
+					continue;
+				}
+
+				hasEmptyBlock = true;
+			}
+
+			VkDeviceSize offset = spMemoryBlock->Allocate(memoryRequirements.size, memoryRequirements.alignment);
+
+			if (offset != VK_WHOLE_SIZE)
+			{
+				pAllocation->spMemoryBlock		= spMemoryBlock;
+				pAllocation->offset				= offset;
+				pAllocation->size				= memoryRequirements.size;
+
+				return Result::eSuccess;
+			}
+
+			i++;
+		}
+	}
+
+	std::shared_ptr<MemoryBlock> spMemoryBlock;
+
+	Result eResult = this->CreateBlock(&spMemoryBlock, isDedicated ? memoryRequirements.size : blockSize, memoryTypeIndex);
+
+	if (eResult == Result::eSuccess)
+	{
+		pAllocation->spMemoryBlock		= spMemoryBlock;
+		pAllocation->offset				= spMemoryBlock->Allocate(memoryRequirements.size, memoryRequirements.alignment);
+		pAllocation->size				= memoryRequirements.size;
+
+		if (isDedicated)
+		{
+			m_DedicatedBlocks.erase(std::remove_if(m_DedicatedBlocks.begin(), m_DedicatedBlocks.end(),
+												   [](const std::weak_ptr<MemoryBlock> & wpMemoryBlock) { return wpMemoryBlock.expired(); }),
+									m_DedicatedBlocks.end());
+
+			m_DedicatedBlocks.push_back(spMemoryBlock);
+		}
+		else
+		{
+			MemoryBlocks.push_back(spMemoryBlock);
+		}
+	}
+
+	return eResult;
+}
+
+
+uint32_t MemoryAllocator::GetBlockCount() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	uint32_t blockCount = 0;
+
+	for (auto & MemoryBlocksPerType : m_MemoryBlocks)
+	{
+		for (auto & MemoryBlocks : MemoryBlocksPerType)
+		{
+			blockCount += static_cast<uint32_t>(MemoryBlocks.size());
+		}
+	}
+
+	for (auto & wpMemoryBlock : m_DedicatedBlocks)
+	{
+		blockCount += wpMemoryBlock.expired() ? 0 : 1;
+	}
+
+	return blockCount;
+}
+
+
+MemoryAllocator::~MemoryAllocator()
+{
+
+}
\ No newline at end of file
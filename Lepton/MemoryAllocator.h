@@ -0,0 +1,138 @@
+/*************************************************************************
+**********************    Lepton_MemoryAllocator    **********************
+*************************************************************************/
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "Vulkan.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	*************************    MemoryBlock    **************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Large device memory object, carved into sub-ranges.
+	 */
+	class MemoryBlock
+	{
+		LAVA_NONCOPYABLE(MemoryBlock)
+
+	public:
+
+		//!	@brief	Constructor (handles must be initialized).
+		MemoryBlock(VkDevice hDevice, VkDeviceMemory hDeviceMemory, VkDeviceSize size, uint32_t memoryTypeIndex);
+
+		//!	@brief	Where device memory will be released.
+		~MemoryBlock() noexcept;
+
+	public:
+
+		//!	@brief	Return the size of the block in bytes.
+		VkDeviceSize Size() const { return m_Size; }
+
+		//!	@brief	Return VkDevice handle.
+		VkDevice GetDeviceHandle() const { return m_hDevice; }
+
+		//!	@brief	Return the memory type index of the block.
+		uint32_t GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+
+		//!	@brief	Convert to VkDeviceMemory.
+		operator VkDeviceMemory() const { return m_hDeviceMemory; }
+
+		//!	@brief	Carve an aligned range out of the block, return VK_WHOLE_SIZE on failure.
+		VkDeviceSize Allocate(VkDeviceSize size, VkDeviceSize alignment);
+
+		//!	@brief	Return a range to the block.
+		void Free(VkDeviceSize offset, VkDeviceSize size);
+
+	private:
+
+		//!	@brief	Insert a free range (lock must be held).
+		void InsertFreeRange(VkDeviceSize offset, VkDeviceSize size);
+
+		//!	@brief	Erase a free range (lock must be held).
+		void EraseFreeRange(std::map<VkDeviceSize, VkDeviceSize>::iterator iter);
+
+	private:
+
+		std::mutex										m_Mutex;
+
+		const VkDevice									m_hDevice;
+
+		const VkDeviceSize								m_Size;
+
+		const VkDeviceMemory							m_hDeviceMemory;
+
+		const uint32_t									m_MemoryTypeIndex;
+
+		std::map<VkDeviceSize, VkDeviceSize>			m_FreeRanges;			//!	offset -> size.
+
+		std::multimap<VkDeviceSize, VkDeviceSize>		m_FreeSizes;			//!	size -> offset.
+	};
+
+	/*********************************************************************
+	***********************    MemoryAllocator    ************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Per-device sub-allocator, one block list per memory type.
+	 */
+	class MemoryAllocator
+	{
+		LAVA_NONCOPYABLE(MemoryAllocator)
+
+	public:
+
+		/**
+		 *	@brief	Range carved out of a memory block.
+		 */
+		struct Allocation
+		{
+			std::shared_ptr<MemoryBlock>		spMemoryBlock;
+			VkDeviceSize						offset			= 0;
+			VkDeviceSize						size			= 0;
+		};
+
+	public:
+
+		//!	@brief	Create memory allocator object.
+		explicit MemoryAllocator(const LogicalDevice * pLogicalDevice, VkDeviceSize blockSize = LAVA_DEFAULT_BLOCK_SIZE);
+
+		//!	@brief	Destroy memory allocator object, frees empty blocks (live blocks are kept alive by their allocations).
+		~MemoryAllocator();
+
+	public:
+
+		//!	@brief	Allocate a range from the given memory type, linear and optimal resources never share a block.
+		Result Allocate(Allocation * pAllocation, VkMemoryRequirements memoryRequirements, uint32_t memoryTypeIndex, bool isLinear = true);
+
+		//!	@brief	Return the number of live VkDeviceMemory objects.
+		uint32_t GetBlockCount() const;
+
+	private:
+
+		//!	@brief	Return block size used for the given memory type.
+		VkDeviceSize GetBlockSize(uint32_t memoryTypeIndex) const;
+
+		//!	@brief	Allocate a new memory block.
+		Result CreateBlock(std::shared_ptr<MemoryBlock> * pMemoryBlock, VkDeviceSize size, uint32_t memoryTypeIndex);
+
+	private:
+
+		mutable std::mutex										m_Mutex;
+
+		const VkDevice											m_hDevice;
+
+		const VkDeviceSize										m_BlockSize;
+
+		const PhysicalDevice * const							m_pPhysicalDevice;
+
+		std::vector<std::shared_ptr<MemoryBlock>>				m_MemoryBlocks[VK_MAX_MEMORY_TYPES][2];
+
+		std::vector<std::weak_ptr<MemoryBlock>>					m_DedicatedBlocks;		//!	Released together with their resource.
+	};
+}
\ No newline at end of file
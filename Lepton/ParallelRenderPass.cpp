@@ -0,0 +1,223 @@
+/*************************************************************************
+********************    Lepton_ParallelRenderPass    *********************
+*************************************************************************/
+
+#include "ParallelRenderPass.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+************************    ParallelRenderPass    ************************
+*************************************************************************/
+ParallelRenderPass::ParallelRenderPass()
+	: m_pCommandQueue(nullptr), m_Generation(0), m_PendingCount(0), m_IsExiting(false),
+	m_FrameIndex(0), m_pFramebuffer(nullptr), m_pfnRecord(nullptr)
+{
+
+}
+
+
+Result ParallelRenderPass::Create(CommandQueue * pCommandQueue, uint32_t workerCount, uint32_t frameCount)
+{
+	if (pCommandQueue == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pCommandQueue->IsReady())			return Result::eErrorInvalidDeviceHandle;
+	if (workerCount == 0)					return Result::eErrorInitializationFailed;
+	if (frameCount == 0)					return Result::eErrorInitializationFailed;
+
+	this->Destroy();
+
+	m_pCommandQueue = pCommandQueue;
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		auto pWorker = std::make_unique<Worker>();
+
+		for (uint32_t j = 0; j < frameCount; j++)
+		{
+			CommandPool * pCommandPool = pCommandQueue->CreateCommandPool(vk::CommandPoolCreateFlagBits::eTransient);
+
+			CommandBuffer * pCommandBuffer = (pCommandPool != nullptr) ? pCommandPool->AllocateSecondaryCommandBuffer() : nullptr;
+
+			if (pCommandPool != nullptr)
+			{
+				pWorker->pCommandPools.push_back(pCommandPool);
+			}
+
+			if (pCommandBuffer == nullptr)
+			{
+				m_Workers.push_back(std::move(pWorker));
+
+				this->Destroy();
+
+				return Result::eErrorOutOfDeviceMemory;
+			}
+
+			pWorker->pCommandBuffers.push_back(pCommandBuffer);
+		}
+
+		m_Workers.push_back(std::move(pWorker));
+	}
+
+	//	Threads are started once every worker exists, they index m_Workers.
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		m_Workers[i]->thread = std::thread(&ParallelRenderPass::WorkerLoop, this, i);
+	}
+
+	return Result::eSuccess;
+}
+
+
+Result ParallelRenderPass::Record(CommandBuffer * pPrimary, uint32_t frameIndex, const Framebuffer & framebuffer, VkRect2D renderArea,
+								  vk::ArrayProxy<VkClearValue> pClearValues, const RecordFunction & pfnRecord)
+{
+	if (pPrimary == nullptr)				return Result::eErrorInvalidDeviceHandle;
+	if (m_Workers.empty())					return Result::eErrorInitializationFailed;
+	if (!framebuffer.IsValid())				return Result::eErrorInvalidRenderPassHandle;
+
+	if (frameIndex >= m_Workers[0]->pCommandBuffers.size())		return Result::eErrorInitializationFailed;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_FrameIndex = frameIndex;
+
+		m_pFramebuffer = &framebuffer;
+
+		m_pfnRecord = &pfnRecord;
+
+		m_PendingCount = static_cast<uint32_t>(m_Workers.size());
+
+		m_Generation++;
+	}
+
+	m_WorkCondition.notify_all();
+
+	//	The primary is recorded while the workers fill the secondaries.
+	pPrimary->CmdBeginRenderPass(framebuffer, renderArea, pClearValues, vk::SubpassContents::eSecondaryCommandBuffers);
+
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		m_DoneCondition.wait(lock, [this]() { return m_PendingCount == 0; });
+
+		m_pFramebuffer = nullptr;
+
+		m_pfnRecord = nullptr;
+	}
+
+	std::vector<CommandBuffer*> pSecondaries;
+
+	pSecondaries.reserve(m_Workers.size());
+
+	Result eResult = Result::eSuccess;
+
+	for (auto & pWorker : m_Workers)
+	{
+		if (pWorker->eResult != Result::eSuccess)
+		{
+			eResult = pWorker->eResult;
+		}
+
+		pSecondaries.push_back(pWorker->pCommandBuffers[frameIndex]);
+	}
+
+	if (eResult == Result::eSuccess)
+	{
+		pPrimary->CmdExecuteCommands(pSecondaries);
+	}
+
+	pPrimary->CmdEndRenderPass();
+
+	return eResult;
+}
+
+
+void ParallelRenderPass::WorkerLoop(uint32_t workerIndex)
+{
+	uint64_t generation = 0;
+
+	Worker & worker = *m_Workers[workerIndex];
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			m_WorkCondition.wait(lock, [&]() { return m_IsExiting || (m_Generation != generation); });
+
+			if (m_IsExiting)		return;
+
+			generation = m_Generation;
+		}
+
+		worker.eResult = this->RecordSecondary(worker, workerIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (--m_PendingCount == 0)
+			{
+				m_DoneCondition.notify_one();
+			}
+		}
+	}
+}
+
+
+Result ParallelRenderPass::RecordSecondary(Worker & worker, uint32_t workerIndex)
+{
+	//	Keep the pool memory, the buffer is re-recorded every time this slot comes around.
+	Result eResult = worker.pCommandPools[m_FrameIndex]->Reset(0);
+
+	if (eResult != Result::eSuccess)		return eResult;
+
+	CommandBuffer * pCommandBuffer = worker.pCommandBuffers[m_FrameIndex];
+
+	eResult = pCommandBuffer->BeginRecord(*m_pFramebuffer, 0, vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+	if (eResult != Result::eSuccess)		return eResult;
+
+	(*m_pfnRecord)(pCommandBuffer, workerIndex);
+
+	return pCommandBuffer->EndRecord();
+}
+
+
+void ParallelRenderPass::Destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_IsExiting = true;
+	}
+
+	m_WorkCondition.notify_all();
+
+	for (auto & pWorker : m_Workers)
+	{
+		if (pWorker->thread.joinable())
+		{
+			pWorker->thread.join();
+		}
+
+		for (auto pCommandPool : pWorker->pCommandPools)
+		{
+			m_pCommandQueue->DestroyCommandPool(pCommandPool);
+		}
+	}
+
+	m_Workers.clear();
+
+	m_IsExiting = false;
+
+	m_Generation = 0;
+
+	m_pCommandQueue = nullptr;
+}
+
+
+ParallelRenderPass::~ParallelRenderPass()
+{
+	this->Destroy();
+}
\ No newline at end of file
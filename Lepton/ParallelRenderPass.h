@@ -0,0 +1,102 @@
+/*************************************************************************
+********************    Lepton_ParallelRenderPass    *********************
+*************************************************************************/
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include "Commands.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	**********************    ParallelRenderPass    **********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Records one render pass on several worker threads, each into a secondary command buffer of its own pool.
+	 *	@note	Command pools are kept per frame slot, the previous submission of a slot must have completed before it is recorded again.
+	 */
+	class ParallelRenderPass
+	{
+		LAVA_NONCOPYABLE(ParallelRenderPass)
+
+	public:
+
+		//!	@brief	Records the share of workerIndex into a secondary command buffer (called on the worker thread).
+		using RecordFunction = std::function<void(CommandBuffer * pCommandBuffer, uint32_t workerIndex)>;
+
+	public:
+
+		//!	@brief	Create parallel render pass object.
+		ParallelRenderPass();
+
+		//!	@brief	Destroy parallel render pass object.
+		~ParallelRenderPass();
+
+	public:
+
+		//!	@brief	Create worker threads with one command pool per frame slot, on the queue the primary buffers are submitted to.
+		Result Create(CommandQueue * pCommandQueue, uint32_t workerCount, uint32_t frameCount = 2);
+
+		/**
+		 *	@brief		Record a single-subpass render pass into pPrimary, contents are recorded by all workers in parallel.
+		 *	@note		Secondary command buffers are executed in worker order, so workerIndex decides the draw order.
+		 */
+		Result Record(CommandBuffer * pPrimary, uint32_t frameIndex, const Framebuffer & framebuffer, VkRect2D renderArea,
+					  vk::ArrayProxy<VkClearValue> pClearValues, const RecordFunction & pfnRecord);
+
+		//!	@brief	Return the number of worker threads.
+		uint32_t WorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+		//!	@brief	Join worker threads and destroy the command pools.
+		void Destroy();
+
+	private:
+
+		/**
+		 *	@brief	Worker thread with its command pools.
+		 */
+		struct Worker
+		{
+			std::thread							thread;
+			Result								eResult			= Result::eSuccess;
+			std::vector<CommandPool*>			pCommandPools;
+			std::vector<CommandBuffer*>			pCommandBuffers;
+		};
+
+	private:
+
+		//!	@brief	Entry of worker threads.
+		void WorkerLoop(uint32_t workerIndex);
+
+		//!	@brief	Record the secondary command buffer of the current job.
+		Result RecordSecondary(Worker & worker, uint32_t workerIndex);
+
+	private:
+
+		std::mutex								m_Mutex;
+
+		std::condition_variable					m_WorkCondition;
+
+		std::condition_variable					m_DoneCondition;
+
+		CommandQueue *							m_pCommandQueue;
+
+		uint64_t								m_Generation;
+
+		uint32_t								m_PendingCount;
+
+		bool									m_IsExiting;
+
+		uint32_t								m_FrameIndex;
+
+		const Framebuffer *						m_pFramebuffer;
+
+		const RecordFunction *					m_pfnRecord;
+
+		std::vector<std::unique_ptr<Worker>>	m_Workers;
+	};
+}
\ No newline at end of file
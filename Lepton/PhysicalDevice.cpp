@@ -2,6 +2,8 @@
 **********************    Lepton_PhysicalDevice    ***********************
 *************************************************************************/
 
+#include <bit>
+#include <algorithm>
 #include "Commands.h"
 #include "Instance.h"
 #include "LogicalDevice.h"
@@ -85,6 +87,71 @@ uint32_t PhysicalDevice::GetMemoryTypeIndex(uint32_t memoryTypeBits, vk::MemoryP
 }
 
 
+std::vector<uint32_t> PhysicalDevice::GetMemoryTypeIndices(uint32_t memoryTypeBits, MemoryUsage eUsage) const
+{
+	VkMemoryPropertyFlags eRequired = 0, ePreferred = 0, eNiceToHave = 0, eAvoided = 0;
+
+	switch (eUsage)
+	{
+	case MemoryUsage::eGpuOnly:
+		ePreferred		= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		eAvoided		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+		break;
+	case MemoryUsage::eCpuOnly:
+		eRequired		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		eAvoided		= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		break;
+	case MemoryUsage::eCpuToGpu:
+		eRequired		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+		ePreferred		= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		eNiceToHave		= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		eAvoided		= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+		break;
+	case MemoryUsage::eGpuToCpu:
+		eRequired		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+		ePreferred		= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+		eNiceToHave		= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		break;
+	case MemoryUsage::eGpuLazy:
+		eRequired		= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		ePreferred		= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+		eAvoided		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+		break;
+	}
+
+	struct Candidate { uint32_t memoryTypeIndex; int score; VkDeviceSize heapSize; };
+
+	std::vector<Candidate> Candidates;
+
+	for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+	{
+		VkMemoryPropertyFlags eFlags = m_MemoryProperties.memoryTypes[i].propertyFlags;
+
+		if ((memoryTypeBits & (1u << i)) == 0)				continue;
+		if ((eFlags & eRequired) != eRequired)				continue;
+
+		int score = 100 * std::popcount(eFlags & ePreferred) + 10 * std::popcount(eFlags & eNiceToHave) - 50 * std::popcount(eFlags & eAvoided);
+
+		Candidates.push_back({ i, score, m_MemoryProperties.memoryHeaps[m_MemoryProperties.memoryTypes[i].heapIndex].size });
+	}
+
+	//	Equal scores: the larger heap is less likely to run out.
+	std::stable_sort(Candidates.begin(), Candidates.end(), [](const Candidate & a, const Candidate & b)
+	{
+		return (a.score != b.score) ? (a.score > b.score) : (a.heapSize > b.heapSize);
+	});
+
+	std::vector<uint32_t> MemoryTypeIndices(Candidates.size());
+
+	for (size_t i = 0; i < Candidates.size(); i++)
+	{
+		MemoryTypeIndices[i] = Candidates[i].memoryTypeIndex;
+	}
+
+	return MemoryTypeIndices;
+}
+
+
 const std::vector<VkQueueFamilyProperties> & PhysicalDevice::GetQueueFamilies() const
 {
 	if (m_QueueFamilyProperties.empty())
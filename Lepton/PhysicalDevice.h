@@ -4,6 +4,7 @@
 #pragma once
 
 #include <set>
+#include <vector>
 #include "Vulkan.h"
 #include "Win32Surface.h"
 
@@ -57,6 +58,12 @@ namespace Lepton
 		//!	@brief	Get the index of a memory type that has all the requested property bits set.
 		uint32_t GetMemoryTypeIndex(uint32_t memoryTypeBits, vk::MemoryPropertyFlags eProperties) const;
 
+		//!	@brief	Return acceptable memory types for the usage, best first (try the next one when a heap is exhausted).
+		std::vector<uint32_t> GetMemoryTypeIndices(uint32_t memoryTypeBits, MemoryUsage eUsage) const;
+
+		//!	@brief	Return the memory types and heaps.
+		const VkPhysicalDeviceMemoryProperties & GetMemoryProperties() const { return m_MemoryProperties; }
+
 		//!	@brief	Return the physical properties.
 		const VkPhysicalDeviceProperties & GetProperties() const { return m_Properties.properties; }
 
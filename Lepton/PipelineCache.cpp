@@ -0,0 +1,188 @@
+/*************************************************************************
+**********************    Lepton_PipelineCache    ************************
+*************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include "PipelineCache.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+**************************    PipelineCache    ***************************
+*************************************************************************/
+PipelineCache::PipelineCache() : m_hDevice(VK_NULL_HANDLE), m_hPipelineCache(VK_NULL_HANDLE), m_VendorID(0), m_DeviceID(0), m_PipelineCacheUUID{}
+{
+
+}
+
+
+Result PipelineCache::Create(VkDevice hDevice, const VkPhysicalDeviceProperties & Properties)
+{
+	if (hDevice == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	VkPipelineCacheCreateInfo			CreateInfo = {};
+	CreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	CreateInfo.pNext					= nullptr;
+	CreateInfo.flags					= 0;
+	CreateInfo.initialDataSize			= 0;
+	CreateInfo.pInitialData				= nullptr;
+
+	VkPipelineCache hPipelineCache = VK_NULL_HANDLE;
+
+	VkResult eResult = vkCreatePipelineCache(hDevice, &CreateInfo, nullptr, &hPipelineCache);
+
+	if (eResult == VK_SUCCESS)
+	{
+		this->Destroy();
+
+		m_hDevice = hDevice;
+
+		m_hPipelineCache = hPipelineCache;
+
+		m_VendorID = Properties.vendorID;
+
+		m_DeviceID = Properties.deviceID;
+
+		std::memcpy(m_PipelineCacheUUID, Properties.pipelineCacheUUID, VK_UUID_SIZE);
+	}
+
+	return LAVA_RESULT_CAST(eResult);
+}
+
+
+bool PipelineCache::IsCompatible(const void * pData, size_t sizeBytes) const
+{
+	//	Layout of VkPipelineCacheHeaderVersionOne, read field by field since the data has no alignment guarantee.
+	constexpr size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+	if ((pData == nullptr) || (sizeBytes < headerSize))		return false;
+
+	uint32_t Fields[4] = {};
+
+	std::memcpy(Fields, pData, sizeof(Fields));
+
+	if (Fields[0] < headerSize)										return false;
+	if (Fields[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)			return false;
+	if (Fields[2] != m_VendorID)									return false;
+	if (Fields[3] != m_DeviceID)									return false;
+
+	return std::memcmp(static_cast<const uint8_t*>(pData) + sizeof(Fields), m_PipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+
+Result PipelineCache::Load(const char * pFilePath)
+{
+	if (m_hPipelineCache == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	std::vector<char> CacheData;
+
+	std::ifstream Stream(pFilePath, std::ios::ate | std::ios::binary);
+
+	if (Stream.is_open() && Stream.good())
+	{
+		CacheData.resize(static_cast<size_t>(Stream.tellg()));
+
+		Stream.seekg(0);
+
+		Stream.read(CacheData.data(), CacheData.size());
+
+		Stream.close();
+	}
+
+	if (CacheData.empty())		return Result::eErrorInitializationFailed;
+
+	//	Drivers should reject foreign data themselves, but some crash on it instead.
+	if (!this->IsCompatible(CacheData.data(), CacheData.size()))		return Result::eErrorIncompatibleDriver;
+
+	VkPipelineCacheCreateInfo			CreateInfo = {};
+	CreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	CreateInfo.pNext					= nullptr;
+	CreateInfo.flags					= 0;
+	CreateInfo.initialDataSize			= CacheData.size();
+	CreateInfo.pInitialData				= CacheData.data();
+
+	VkPipelineCache hLoadedCache = VK_NULL_HANDLE;
+
+	VkResult eResult = vkCreatePipelineCache(m_hDevice, &CreateInfo, nullptr, &hLoadedCache);
+
+	if (eResult == VK_SUCCESS)
+	{
+		eResult = vkMergePipelineCaches(m_hDevice, m_hPipelineCache, 1, &hLoadedCache);
+
+		vkDestroyPipelineCache(m_hDevice, hLoadedCache, nullptr);
+	}
+
+	return LAVA_RESULT_CAST(eResult);
+}
+
+
+Result PipelineCache::Save(const char * pFilePath) const
+{
+	if (m_hPipelineCache == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	size_t sizeBytes = 0;
+
+	VkResult eResult = vkGetPipelineCacheData(m_hDevice, m_hPipelineCache, &sizeBytes, nullptr);
+
+	if (eResult != VK_SUCCESS)		return LAVA_RESULT_CAST(eResult);
+
+	std::vector<char> CacheData(sizeBytes);
+
+	eResult = vkGetPipelineCacheData(m_hDevice, m_hPipelineCache, &sizeBytes, CacheData.data());
+
+	if (eResult != VK_SUCCESS)		return LAVA_RESULT_CAST(eResult);
+
+	//	Written next to the target and renamed, so a crash never leaves a truncated cache behind.
+	const std::string tempPath = std::string(pFilePath) + ".tmp";
+
+	std::ofstream Stream(tempPath, std::ios::binary | std::ios::trunc);
+
+	if (!Stream.is_open())		return Result::eErrorInitializationFailed;
+
+	Stream.write(CacheData.data(), sizeBytes);
+
+	Stream.close();
+
+	if (Stream.fail())
+	{
+		std::remove(tempPath.c_str());
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	//	Replaces the target in one step (MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows), readers see the old or the new cache.
+	std::error_code errorCode;
+
+	std::filesystem::rename(tempPath, pFilePath, errorCode);
+
+	if (errorCode)
+	{
+		std::remove(tempPath.c_str());
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	return Result::eSuccess;
+}
+
+
+void PipelineCache::Destroy()
+{
+	if (m_hPipelineCache != VK_NULL_HANDLE)
+	{
+		vkDestroyPipelineCache(m_hDevice, m_hPipelineCache, nullptr);
+
+		m_hPipelineCache = VK_NULL_HANDLE;
+
+		m_hDevice = VK_NULL_HANDLE;
+	}
+}
+
+
+PipelineCache::~PipelineCache()
+{
+	this->Destroy();
+}
\ No newline at end of file
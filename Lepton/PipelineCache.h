@@ -0,0 +1,68 @@
+/*************************************************************************
+**********************    Lepton_PipelineCache    ************************
+*************************************************************************/
+#pragma once
+
+#include "Vulkan.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	************************    PipelineCache    *************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Wrapper for Vulkan pipeline cache object, persisted across runs through Load() and Save().
+	 *	@note	Pipeline creation may use it from any thread, Load() must not run concurrently with it.
+	 */
+	class PipelineCache
+	{
+		LAVA_NONCOPYABLE(PipelineCache)
+
+	public:
+
+		//!	@brief	Create pipeline cache object.
+		PipelineCache();
+
+		//!	@brief	Destroy pipeline cache object.
+		~PipelineCache();
+
+	public:
+
+		//!	@brief	Convert to VkPipelineCache.
+		operator VkPipelineCache() const { return m_hPipelineCache; }
+
+		//!	@brief	Return Vulkan type of this object.
+		VkPipelineCache Handle() const { return m_hPipelineCache; }
+
+		//!	@brief	If pipeline cache handle is valid.
+		bool IsValid() const { return m_hPipelineCache != VK_NULL_HANDLE; }
+
+		//!	@brief	Create a new empty pipeline cache for the device.
+		Result Create(VkDevice hDevice, const VkPhysicalDeviceProperties & Properties);
+
+		//!	@brief	Merge a file written by Save(), files of another device or driver version are rejected with eErrorIncompatibleDriver.
+		Result Load(const char * pFilePath);
+
+		//!	@brief	Write the cache contents to a file (replaced atomically).
+		Result Save(const char * pFilePath) const;
+
+		//!	@brief	Whether the data starts with a cache header matching this device.
+		bool IsCompatible(const void * pData, size_t sizeBytes) const;
+
+		//!	@brief	Destroy the pipeline cache.
+		void Destroy();
+
+	private:
+
+		VkDevice					m_hDevice;
+
+		VkPipelineCache				m_hPipelineCache;
+
+		uint32_t					m_VendorID;
+
+		uint32_t					m_DeviceID;
+
+		uint8_t						m_PipelineCacheUUID[VK_UUID_SIZE];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*************************************************************************
+*********************    Lepton_PipelineCompiler    **********************
+*************************************************************************/
+
+#include <algorithm>
+#include "LogicalDevice.h"
+#include "PipelineCompiler.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+*************************    PipelineCompiler    *************************
+*************************************************************************/
+PipelineCompiler::PipelineCompiler() : m_pLogicalDevice(nullptr), m_ActiveCount(0), m_IsExiting(false)
+{
+
+}
+
+
+Result PipelineCompiler::Create(const LogicalDevice * pLogicalDevice, uint32_t threadCount)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
+
+	this->Destroy();
+
+	if (threadCount == 0)
+	{
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	m_pLogicalDevice = pLogicalDevice;
+
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		m_Threads.emplace_back(&PipelineCompiler::WorkerLoop, this);
+	}
+
+	return Result::eSuccess;
+}
+
+
+std::future<Result> PipelineCompiler::Compile(GraphicsPipeline * pPipeline, const GraphicsPipelineParam & Param)
+{
+	const LogicalDevice * pLogicalDevice = m_pLogicalDevice;
+
+	return this->Enqueue(std::packaged_task<Result()>([=]() { return pPipeline->Create(pLogicalDevice, Param); }));
+}
+
+
+std::future<Result> PipelineCompiler::Compile(ComputePipeline * pPipeline, const ComputePipelineParam & Param)
+{
+	const LogicalDevice * pLogicalDevice = m_pLogicalDevice;
+
+	return this->Enqueue(std::packaged_task<Result()>([=]() { return pPipeline->Create(pLogicalDevice, Param); }));
+}
+
+
+std::future<Result> PipelineCompiler::Compile(RayTracingPipelineNV * pPipeline, const RayTracingPipelineParam & Param)
+{
+	const LogicalDevice * pLogicalDevice = m_pLogicalDevice;
+
+	return this->Enqueue(std::packaged_task<Result()>([=]() { return pPipeline->Create(pLogicalDevice, Param); }));
+}
+
+
+std::future<Result> PipelineCompiler::Enqueue(std::packaged_task<Result()> Task)
+{
+	std::future<Result> Future = Task.get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_Threads.empty() && !m_IsExiting)
+		{
+			m_Tasks.push_back(std::move(Task));
+
+			m_WorkCondition.notify_one();
+
+			return Future;
+		}
+	}
+
+	std::promise<Result> Promise;
+
+	Promise.set_value(Result::eErrorInitializationFailed);
+
+	return Promise.get_future();
+}
+
+
+void PipelineCompiler::WorkerLoop()
+{
+	for (;;)
+	{
+		std::packaged_task<Result()> Task;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			m_WorkCondition.wait(lock, [this]() { return m_IsExiting || !m_Tasks.empty(); });
+
+			//	Queued jobs are drained before exiting, so no future is left without a value.
+			if (m_Tasks.empty())		return;
+
+			Task = std::move(m_Tasks.front());
+
+			m_Tasks.pop_front();
+
+			m_ActiveCount++;
+		}
+
+		//	Pipeline creation is safe to run concurrently on one VkPipelineCache, the driver synchronizes it internally.
+		Task();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if ((--m_ActiveCount == 0) && m_Tasks.empty())
+			{
+				m_IdleCondition.notify_all();
+			}
+		}
+	}
+}
+
+
+void PipelineCompiler::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	m_IdleCondition.wait(lock, [this]() { return m_Tasks.empty() && (m_ActiveCount == 0); });
+}
+
+
+void PipelineCompiler::Destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_IsExiting = true;
+	}
+
+	m_WorkCondition.notify_all();
+
+	for (auto & Thread : m_Threads)
+	{
+		Thread.join();
+	}
+
+	m_Threads.clear();
+
+	m_IsExiting = false;
+
+	m_pLogicalDevice = nullptr;
+}
+
+
+PipelineCompiler::~PipelineCompiler()
+{
+	this->Destroy();
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*************************************************************************
+*********************    Lepton_PipelineCompiler    **********************
+*************************************************************************/
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <condition_variable>
+#include "ComputePipeline.h"
+#include "GraphicsPipeline.h"
+#include "RayTracingPipelineNV.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	***********************    PipelineCompiler    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Creates pipelines on a pool of worker threads, all sharing the pipeline cache of the device.
+	 *	@note	The pipeline object passed in must stay alive until its future is ready.
+	 */
+	class PipelineCompiler
+	{
+		LAVA_NONCOPYABLE(PipelineCompiler)
+
+	public:
+
+		//!	@brief	Create pipeline compiler object.
+		PipelineCompiler();
+
+		//!	@brief	Destroy pipeline compiler object (queued jobs are finished first).
+		~PipelineCompiler();
+
+	public:
+
+		//!	@brief	Start worker threads, threadCount = 0 uses one per hardware thread.
+		Result Create(const LogicalDevice * pLogicalDevice, uint32_t threadCount = 0);
+
+		//!	@brief	Queue creation of a graphics pipeline.
+		std::future<Result> Compile(GraphicsPipeline * pPipeline, const GraphicsPipelineParam & Param);
+
+		//!	@brief	Queue creation of a compute pipeline.
+		std::future<Result> Compile(ComputePipeline * pPipeline, const ComputePipelineParam & Param);
+
+		//!	@brief	Queue creation of a ray tracing pipeline.
+		std::future<Result> Compile(RayTracingPipelineNV * pPipeline, const RayTracingPipelineParam & Param);
+
+		//!	@brief	Block until every queued job has finished.
+		void WaitIdle();
+
+		//!	@brief	Return the number of worker threads.
+		uint32_t ThreadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+
+		//!	@brief	Finish queued jobs and join worker threads.
+		void Destroy();
+
+	private:
+
+		//!	@brief	Queue a job, or fail it immediately if no worker is running.
+		std::future<Result> Enqueue(std::packaged_task<Result()> Task);
+
+		//!	@brief	Entry of worker threads.
+		void WorkerLoop();
+
+	private:
+
+		std::mutex									m_Mutex;
+
+		std::condition_variable						m_WorkCondition;
+
+		std::condition_variable						m_IdleCondition;
+
+		const LogicalDevice *						m_pLogicalDevice;
+
+		uint32_t									m_ActiveCount;
+
+		bool										m_IsExiting;
+
+		std::vector<std::thread>					m_Threads;
+
+		std::deque<std::packaged_task<Result()>>	m_Tasks;
+	};
+}
\ No newline at end of file
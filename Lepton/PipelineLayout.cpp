@@ -2,7 +2,9 @@
 **********************    Lepton_PipelineLayout    ***********************
 *************************************************************************/
 
-#include "PipelineLayout.h"
+#include <map>
+#include <algorithm>
+#include "LayoutCache.h"
 
 using namespace Lepton;
 
@@ -71,6 +73,124 @@ Result PipelineLayout::Create(VkDevice hDevice, vk::ArrayProxy<DescriptorSetLayo
 }
 
 
+Result PipelineLayout::CreateFromShaders(VkDevice hDevice, vk::ArrayProxy<const ShaderModule> pShaderModules, LayoutCache * pLayoutCache)
+{
+	if (hDevice == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	std::vector<std::vector<vk::DescriptorSetLayoutBinding>>	SetBindings;
+
+	vk::PushConstantRange PushConstantRange(vk::ShaderStageFlags(), 0, 0);
+
+	uint32_t pushConstantBegin = UINT32_MAX;
+
+	uint32_t pushConstantEnd = 0;
+
+	for (auto & shaderModule : pShaderModules)
+	{
+		if (!shaderModule.IsValid())		return Result::eErrorInvalidSPIRVCode;
+
+		const ShaderReflection & Reflection = shaderModule.GetReflection();
+
+		for (auto & Binding : Reflection.GetDescriptorBindings())
+		{
+			if (SetBindings.size() <= Binding.set)		SetBindings.resize(Binding.set + 1);
+
+			//	Index equals binding number, gaps stay reserved with zero descriptors.
+			std::vector<vk::DescriptorSetLayoutBinding> & LayoutBindings = SetBindings[Binding.set];
+
+			if (LayoutBindings.size() <= Binding.binding)
+			{
+				for (uint32_t i = static_cast<uint32_t>(LayoutBindings.size()); i <= Binding.binding; i++)
+				{
+					LayoutBindings.push_back(vk::DescriptorSetLayoutBinding(i, Binding.eType, 0));
+				}
+			}
+
+			vk::DescriptorSetLayoutBinding & LayoutBinding = LayoutBindings[Binding.binding];
+
+			if (LayoutBinding.descriptorCount == 0)
+			{
+				LayoutBinding.descriptorType = Binding.eType;
+			}
+			else if (LayoutBinding.descriptorType != Binding.eType)
+			{
+				return Result::eErrorInitializationFailed;
+			}
+
+			LayoutBinding.descriptorCount = std::max(LayoutBinding.descriptorCount, Binding.descriptorCount);
+
+			LayoutBinding.stageFlags |= Binding.eStages;
+		}
+
+		const vk::PushConstantRange & StageRange = Reflection.GetPushConstantRange();
+
+		if (StageRange.size != 0)
+		{
+			pushConstantBegin = std::min(pushConstantBegin, StageRange.offset);
+
+			pushConstantEnd = std::max(pushConstantEnd, StageRange.offset + StageRange.size);
+
+			PushConstantRange.stageFlags |= StageRange.stageFlags;
+		}
+	}
+
+	if (pushConstantEnd != 0)
+	{
+		PushConstantRange.offset = pushConstantBegin;
+
+		PushConstantRange.size = pushConstantEnd - pushConstantBegin;
+	}
+
+	std::vector<DescriptorSetLayout>		DescriptorSetLayouts(SetBindings.size());
+
+	for (size_t i = 0; i < SetBindings.size(); i++)
+	{
+		//	Reuse the layout of an earlier set with identical bindings.
+		for (size_t j = 0; j < i; j++)
+		{
+			if (SetBindings[j] == SetBindings[i])
+			{
+				DescriptorSetLayouts[i] = DescriptorSetLayouts[j];
+
+				break;
+			}
+		}
+
+		if (!DescriptorSetLayouts[i].IsValid())
+		{
+			Result eResult = Result::eSuccess;
+
+			if (pLayoutCache != nullptr)
+			{
+				DescriptorSetLayouts[i] = pLayoutCache->GetDescriptorSetLayout(SetBindings[i], &eResult);
+			}
+			else
+			{
+				eResult = DescriptorSetLayouts[i].Create(hDevice, SetBindings[i]);
+			}
+
+			if (eResult != Result::eSuccess)		return eResult;
+		}
+	}
+
+	if (pLayoutCache != nullptr)
+	{
+		Result eResult = Result::eSuccess;
+
+		*this = pLayoutCache->GetPipelineLayout(DescriptorSetLayouts, (PushConstantRange.size != 0) ? vk::ArrayProxy<const vk::PushConstantRange>(PushConstantRange) : nullptr, &eResult);
+
+		return eResult;
+	}
+
+	if (PushConstantRange.size == 0)
+	{
+		return this->Create(hDevice, DescriptorSetLayouts);
+	}
+
+	return this->Create(hDevice, DescriptorSetLayouts, PushConstantRange);
+}
+
+
 PipelineLayout::UniqueHandle::~UniqueHandle() noexcept
 {
 	if (m_hPipelineLayout != VK_NULL_HANDLE)
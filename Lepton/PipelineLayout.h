@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DescriptorSet.h"
+#include "ShaderModule.h"
 
 namespace Lepton
 {
@@ -31,6 +32,14 @@ namespace Lepton
 		//!	@brief	Create a new pipeline layout.
 		Result Create(VkDevice hDevice, vk::ArrayProxy<DescriptorSetLayout> pDescriptorSetLayouts = nullptr, vk::ArrayProxy<vk::PushConstantRange> pPushConstantRanges = nullptr);
 
+		/**
+		 *	@brief	Create a new pipeline layout from the reflected resources of all shader stages.
+		 *	@note	Bindings are merged across stages (stage flags are combined), sets without bindings get empty layouts,
+		 *			stages with identical bindings of a set share one descriptor set layout, and one push constant
+		 *			range covers the blocks of all stages. With a layout cache, all layouts are interned.
+		 */
+		Result CreateFromShaders(VkDevice hDevice, vk::ArrayProxy<const ShaderModule> pShaderModules, LayoutCache * pLayoutCache = nullptr);
+
 		//!	@brief	Convert to VkPipelineLayout.
 		operator VkPipelineLayout() const { return m_spUniqueHandle != nullptr ? m_spUniqueHandle->m_hPipelineLayout : VK_NULL_HANDLE; }
 
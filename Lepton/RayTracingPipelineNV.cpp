@@ -3,6 +3,8 @@
 *************************************************************************/
 
 #include "RayTracingPipelineNV.h"
+#include "LogicalDevice.h"
+#include "PipelineCache.h"
 
 using namespace Lepton;
 
@@ -15,19 +17,23 @@ RayTracingPipelineNV::RayTracingPipelineNV() : m_hDevice(VK_NULL_HANDLE), m_hRay
 }
 
 
-RayTracingPipelineNV::RayTracingPipelineNV(const RayTracingPipelineParam & Param)
+RayTracingPipelineNV::RayTracingPipelineNV(const LogicalDevice * pLogicalDevice, const RayTracingPipelineParam & Param) : RayTracingPipelineNV()
 {
-	this->Create(Param);
+	this->Create(pLogicalDevice, Param);
 }
 
 
-Result RayTracingPipelineNV::Create(const RayTracingPipelineParam & Param)
+Result RayTracingPipelineNV::Create(const LogicalDevice * pLogicalDevice, const RayTracingPipelineParam & Param)
 {
+	if (pLogicalDevice == nullptr)				return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())				return Result::eErrorInvalidDeviceHandle;
 	if (!Param.pipelineLayout.IsValid())		return Result::eErrorInvalidPipelineLayoutHandle;
 
+	if (Param.pipelineLayout.GetDeviceHandle() != pLogicalDevice->Handle())		return Result::eErrorInvalidDeviceHandle;
+
 	PFN_vkCreateRayTracingPipelinesNV			pfnCreateRayTracingPipelines = nullptr;
 
-	pfnCreateRayTracingPipelines				= (PFN_vkCreateRayTracingPipelinesNV)vkGetDeviceProcAddr(Param.pipelineLayout.GetDeviceHandle(), "vkCreateRayTracingPipelinesNV");
+	pfnCreateRayTracingPipelines				= (PFN_vkCreateRayTracingPipelinesNV)vkGetDeviceProcAddr(pLogicalDevice->Handle(), "vkCreateRayTracingPipelinesNV");
 
 	if (!pfnCreateRayTracingPipelines)			return Result::eErrorFailedToGetProcessAddress;
 
@@ -65,13 +71,13 @@ Result RayTracingPipelineNV::Create(const RayTracingPipelineParam & Param)
 
 	VkPipeline hPipeline = VK_NULL_HANDLE;
 
-	Result eResult = LAVA_RESULT_CAST(pfnCreateRayTracingPipelines(Param.pipelineLayout.GetDeviceHandle(), VK_NULL_HANDLE, 1, &CreateInfo, nullptr, &hPipeline));
+	Result eResult = LAVA_RESULT_CAST(pfnCreateRayTracingPipelines(pLogicalDevice->Handle(), pLogicalDevice->GetPipelineCache()->Handle(), 1, &CreateInfo, nullptr, &hPipeline));
 
 	if (eResult == Result::eSuccess)
 	{
 		this->Destroy();
 
-		m_hDevice = Param.pipelineLayout.GetDeviceHandle();
+		m_hDevice = pLogicalDevice->Handle();
 
 		m_hRayTracingPipelineNV = hPipeline;
 
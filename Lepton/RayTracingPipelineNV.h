@@ -73,15 +73,15 @@ namespace Lepton
 		RayTracingPipelineNV();
 
 		//!	@brief	Create and initialize immediately.
-		explicit RayTracingPipelineNV(const RayTracingPipelineParam & Param);
+		explicit RayTracingPipelineNV(const LogicalDevice * pLogicalDevice, const RayTracingPipelineParam & Param);
 
 		//!	@brief	Destroy ray tracing pipeline object.
 		~RayTracingPipelineNV();
 
 	public:
 
-		//!	@brief	Create a new ray tracing pipeline.
-		Result Create(const RayTracingPipelineParam & Param);
+		//!	@brief	Create a new ray tracing pipeline through the pipeline cache of the device.
+		Result Create(const LogicalDevice * pLogicalDevice, const RayTracingPipelineParam & Param);
 
 		//!	@brief	Return pipeline parameters.
 		const RayTracingPipelineParam & GetParam() const { return m_Parameter; }
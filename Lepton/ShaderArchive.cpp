@@ -0,0 +1,305 @@
+/*************************************************************************
+**********************    Lepton_ShaderArchive    ************************
+*************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include "ShaderArchive.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+using namespace Lepton;
+
+/*************************************************************************
+**************************    ShaderArchive    ***************************
+*************************************************************************/
+ShaderArchive::ShaderArchive() : m_pMappedData(nullptr), m_MappedSize(0)
+{
+
+}
+
+
+uint64_t ShaderArchive::Hash(const void * pData, size_t sizeBytes)
+{
+	uint64_t hash = HashSeed;
+
+	HashBytes(hash, pData, sizeBytes);
+
+	return hash;
+}
+
+
+Result ShaderArchive::Open(const char * pArchivePath)
+{
+	this->Close();
+
+	const void * pMappedData = nullptr;
+
+	size_t mappedSize = 0;
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(pArchivePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (hFile == INVALID_HANDLE_VALUE)		return Result::eErrorInitializationFailed;
+
+	LARGE_INTEGER fileSize = {};
+
+	if (!GetFileSizeEx(hFile, &fileSize))
+	{
+		CloseHandle(hFile);
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	mappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+	HANDLE hFileMapping = (mappedSize != 0) ? CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+
+	if (hFileMapping != nullptr)
+	{
+		pMappedData = MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0);
+
+		//	The view keeps the mapping alive.
+		CloseHandle(hFileMapping);
+	}
+
+	CloseHandle(hFile);
+#else
+	int fd = open(pArchivePath, O_RDONLY);
+
+	if (fd < 0)		return Result::eErrorInitializationFailed;
+
+	struct stat fileStat = {};
+
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	mappedSize = static_cast<size_t>(fileStat.st_size);
+
+	if (mappedSize != 0)
+	{
+		void * pAddress = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		pMappedData = (pAddress != MAP_FAILED) ? pAddress : nullptr;
+	}
+
+	close(fd);
+#endif
+
+	if (pMappedData == nullptr)		return Result::eErrorMemoryMapFailed;
+
+	m_pMappedData = static_cast<const uint8_t*>(pMappedData);
+
+	m_MappedSize = mappedSize;
+
+	//	Validate the index once, so lookups need no bounds checks.
+	const Header * pHeader = reinterpret_cast<const Header*>(m_pMappedData);
+
+	bool isValid = (m_MappedSize >= sizeof(Header)) && (pHeader->magic == Magic) && (pHeader->version == Version) &&
+				   (pHeader->entryCount <= (m_MappedSize - sizeof(Header)) / sizeof(Entry));
+
+	const Entry * pEntries = reinterpret_cast<const Entry*>(pHeader + 1);
+
+	for (uint32_t i = 0; isValid && (i < pHeader->entryCount); i++)
+	{
+		isValid = (pEntries[i].offset % sizeof(uint32_t) == 0) && (pEntries[i].offset <= m_MappedSize) &&
+				  (pEntries[i].wordCount <= (m_MappedSize - pEntries[i].offset) / sizeof(uint32_t)) &&
+				  ((i == 0) || (pEntries[i - 1].nameHash < pEntries[i].nameHash));
+	}
+
+	if (!isValid)
+	{
+		this->Close();
+
+		return Result::eErrorFormatNotSupported;
+	}
+
+	return Result::eSuccess;
+}
+
+
+vk::ArrayProxy<const uint32_t> ShaderArchive::Find(const char * pName) const
+{
+	if ((m_pMappedData == nullptr) || (pName == nullptr))		return nullptr;
+
+	const uint64_t nameHash = Hash(pName, std::strlen(pName));
+
+	const Entry * pBegin = reinterpret_cast<const Entry*>(m_pMappedData + sizeof(Header));
+
+	const Entry * pEnd = pBegin + this->EntryCount();
+
+	const Entry * pEntry = std::lower_bound(pBegin, pEnd, nameHash, [](const Entry & entry, uint64_t hash) { return entry.nameHash < hash; });
+
+	if ((pEntry == pEnd) || (pEntry->nameHash != nameHash))		return nullptr;
+
+	return vk::ArrayProxy<const uint32_t>(static_cast<uint32_t>(pEntry->wordCount), reinterpret_cast<const uint32_t*>(m_pMappedData + pEntry->offset));
+}
+
+
+bool ShaderArchive::Verify() const
+{
+	if (m_pMappedData == nullptr)		return false;
+
+	const Entry * pEntries = reinterpret_cast<const Entry*>(m_pMappedData + sizeof(Header));
+
+	for (uint32_t i = 0; i < this->EntryCount(); i++)
+	{
+		if (Hash(m_pMappedData + pEntries[i].offset, pEntries[i].wordCount * sizeof(uint32_t)) != pEntries[i].contentHash)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+void ShaderArchive::Close()
+{
+	if (m_pMappedData != nullptr)
+	{
+	#ifdef _WIN32
+		UnmapViewOfFile(m_pMappedData);
+	#else
+		munmap(const_cast<uint8_t*>(m_pMappedData), m_MappedSize);
+	#endif
+
+		m_pMappedData = nullptr;
+
+		m_MappedSize = 0;
+	}
+}
+
+
+Result ShaderArchive::Pack(const char * pArchivePath, vk::ArrayProxy<const char * const> pShaderPaths)
+{
+	std::vector<Entry> Entries;
+
+	std::vector<uint8_t> BlobData;
+
+	for (uint32_t i = 0; i < pShaderPaths.size(); i++)
+	{
+		const char * pShaderPath = *(pShaderPaths.data() + i);
+
+		std::ifstream Stream(pShaderPath, std::ios::ate | std::ios::binary);
+
+		if (!Stream.is_open() || !Stream.good())		return Result::eErrorInitializationFailed;
+
+		const size_t sizeBytes = static_cast<size_t>(Stream.tellg());
+
+		if ((sizeBytes == 0) || (sizeBytes % sizeof(uint32_t) != 0))		return Result::eErrorInvalidSPIRVCode;
+
+		std::vector<uint8_t> Code(sizeBytes);
+
+		Stream.seekg(0);
+
+		Stream.read(reinterpret_cast<char*>(Code.data()), sizeBytes);
+
+		Entry						NewEntry = {};
+		NewEntry.nameHash			= Hash(pShaderPath, std::strlen(pShaderPath));
+		NewEntry.contentHash		= Hash(Code.data(), Code.size());
+		NewEntry.wordCount			= sizeBytes / sizeof(uint32_t);
+		NewEntry.offset				= UINT64_MAX;
+
+		//	Shaders with identical code share one blob.
+		for (auto & entry : Entries)
+		{
+			if ((entry.contentHash == NewEntry.contentHash) && (entry.wordCount == NewEntry.wordCount) &&
+				(std::memcmp(BlobData.data() + entry.offset, Code.data(), sizeBytes) == 0))
+			{
+				NewEntry.offset = entry.offset;
+
+				break;
+			}
+		}
+
+		if (NewEntry.offset == UINT64_MAX)
+		{
+			BlobData.resize((BlobData.size() + BlobAlignment - 1) / BlobAlignment * BlobAlignment);
+
+			NewEntry.offset = BlobData.size();
+
+			BlobData.insert(BlobData.end(), Code.begin(), Code.end());
+		}
+
+		Entries.push_back(NewEntry);
+	}
+
+	std::sort(Entries.begin(), Entries.end(), [](const Entry & a, const Entry & b) { return a.nameHash < b.nameHash; });
+
+	for (size_t i = 1; i < Entries.size(); i++)
+	{
+		if (Entries[i - 1].nameHash == Entries[i].nameHash)		return Result::eErrorInitializationFailed;
+	}
+
+	//	Blob offsets become file offsets once the header and index size is known.
+	const uint64_t blobBegin = (sizeof(Header) + sizeof(Entry) * Entries.size() + BlobAlignment - 1) / BlobAlignment * BlobAlignment;
+
+	for (auto & entry : Entries)
+	{
+		entry.offset += blobBegin;
+	}
+
+	Header						FileHeader = {};
+	FileHeader.magic			= Magic;
+	FileHeader.version			= Version;
+	FileHeader.entryCount		= static_cast<uint32_t>(Entries.size());
+	FileHeader.reserved			= 0;
+
+	const std::vector<uint8_t> Padding(blobBegin - sizeof(Header) - sizeof(Entry) * Entries.size(), 0);
+
+	//	Write to a temporary file first, a mapped archive is never seen half-written.
+	const std::string tempPath = std::string(pArchivePath) + ".tmp";
+
+	std::ofstream Stream(tempPath, std::ios::binary | std::ios::trunc);
+
+	if (!Stream.is_open())		return Result::eErrorInitializationFailed;
+
+	Stream.write(reinterpret_cast<const char*>(&FileHeader), sizeof(Header));
+	Stream.write(reinterpret_cast<const char*>(Entries.data()), sizeof(Entry) * Entries.size());
+	Stream.write(reinterpret_cast<const char*>(Padding.data()), Padding.size());
+	Stream.write(reinterpret_cast<const char*>(BlobData.data()), BlobData.size());
+	Stream.close();
+
+	if (!Stream.good())
+	{
+		std::remove(tempPath.c_str());
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	//	Replaces the target in one step, readers see the old or the new archive (never a missing one).
+	std::error_code errorCode;
+
+	std::filesystem::rename(tempPath, pArchivePath, errorCode);
+
+	if (errorCode)
+	{
+		std::remove(tempPath.c_str());
+
+		return Result::eErrorInitializationFailed;
+	}
+
+	return Result::eSuccess;
+}
+
+
+ShaderArchive::~ShaderArchive()
+{
+	this->Close();
+}
\ No newline at end of file
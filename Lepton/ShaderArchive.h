@@ -0,0 +1,91 @@
+/*************************************************************************
+**********************    Lepton_ShaderArchive    ************************
+*************************************************************************/
+#pragma once
+
+#include "Vulkan.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	************************    ShaderArchive    *************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Read-only view of a packed shader archive, mapped into memory as a whole.
+	 *	@note	Layout: header, index sorted by name hash, then SPIR-V blobs aligned to 16 bytes.
+	 *			Identical blobs are stored once. Returned code stays valid until the archive is closed.
+	 */
+	class ShaderArchive
+	{
+		LAVA_NONCOPYABLE(ShaderArchive)
+
+	public:
+
+		//!	@brief	Create shader archive object.
+		ShaderArchive();
+
+		//!	@brief	Close the archive.
+		~ShaderArchive();
+
+	public:
+
+		//!	@brief	Whether an archive is mapped.
+		bool IsOpen() const { return m_pMappedData != nullptr; }
+
+		//!	@brief	Map an archive file and validate its header and index.
+		Result Open(const char * pArchivePath);
+
+		//!	@brief	Return SPIR-V words of the shader packed under pName (empty if not found).
+		vk::ArrayProxy<const uint32_t> Find(const char * pName) const;
+
+		//!	@brief	Return number of shaders in the archive.
+		uint32_t EntryCount() const { return (m_pMappedData != nullptr) ? reinterpret_cast<const Header*>(m_pMappedData)->entryCount : 0; }
+
+		//!	@brief	Check content hashes of all blobs (reads the whole file).
+		bool Verify() const;
+
+		//!	@brief	Unmap the archive.
+		void Close();
+
+		//!	@brief	Pack SPIR-V files into a new archive, each shader is looked up later by the path given here.
+		static Result Pack(const char * pArchivePath, vk::ArrayProxy<const char * const> pShaderPaths);
+
+	private:
+
+		/**
+		 *	@brief	File header.
+		 */
+		struct Header
+		{
+			uint32_t		magic;
+			uint32_t		version;
+			uint32_t		entryCount;
+			uint32_t		reserved;
+		};
+
+		/**
+		 *	@brief	Index entry of one shader.
+		 */
+		struct Entry
+		{
+			uint64_t		nameHash;
+			uint64_t		contentHash;
+			uint64_t		offset;				//!	Bytes from the start of the file.
+			uint64_t		wordCount;
+		};
+
+		static constexpr uint32_t		Magic				= 0x4153454C;		//!	"LESA"
+		static constexpr uint32_t		Version				= 1;
+		static constexpr uint64_t		BlobAlignment		= 16;
+
+		//!	@brief	Return 64-bit FNV-1a hash of bytes.
+		static uint64_t Hash(const void * pData, size_t sizeBytes);
+
+	private:
+
+		const uint8_t *			m_pMappedData;
+
+		size_t					m_MappedSize;
+	};
+}
\ No newline at end of file
@@ -3,14 +3,17 @@
 *************************************************************************/
 
 #include <fstream>
+#include <algorithm>
 #include "ShaderModule.h"
+#include "ShaderArchive.h"
 
 using namespace Lepton;
 
 /*************************************************************************
 ***************************    ShaderModule    ***************************
 *************************************************************************/
-ShaderModule::UniqueHandle::UniqueHandle(VkDevice hDevice, VkShaderModule hShaderModule, vk::ShaderStageFlagBits eStage) : m_hDevice(hDevice)
+ShaderModule::UniqueHandle::UniqueHandle(VkDevice hDevice, VkShaderModule hShaderModule, vk::ShaderStageFlagBits eStage, const ShaderReflection & Reflection)
+	: m_hDevice(hDevice), m_Reflection(Reflection)
 {
 	m_StageInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	m_StageInfo.pNext					= nullptr;
@@ -22,11 +25,18 @@ ShaderModule::UniqueHandle::UniqueHandle(VkDevice hDevice, VkShaderModule hShade
 }
 
 
-Result ShaderModule::Create(VkDevice hDevice, vk::ArrayProxy<uint32_t> pCode, vk::ShaderStageFlagBits eStage)
+Result ShaderModule::Create(VkDevice hDevice, vk::ArrayProxy<const uint32_t> pCode, vk::ShaderStageFlagBits eStage)
 {
 	if (pCode.empty() == true)			return Result::eErrorInvalidSPIRVCode;
 	if (hDevice == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
 
+	ShaderReflection Reflection;
+
+	if (Reflection.Reflect(pCode, eStage) != Result::eSuccess)
+	{
+		return Result::eErrorInvalidSPIRVCode;
+	}
+
 	VkShaderModuleCreateInfo			CreateInfo = {};
 	CreateInfo.sType					= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 	CreateInfo.pNext					= nullptr;
@@ -40,7 +50,7 @@ Result ShaderModule::Create(VkDevice hDevice, vk::ArrayProxy<uint32_t> pCode, vk
 
 	if (eResult == Result::eSuccess)
 	{
-		m_spUniqueHandle = std::make_shared<UniqueHandle>(hDevice, hShaderModule, eStage);
+		m_spUniqueHandle = std::make_shared<UniqueHandle>(hDevice, hShaderModule, eStage, Reflection);
 	}
 
 	return eResult;
@@ -73,10 +83,71 @@ Result ShaderModule::Create(VkDevice hDevice, const char * pShaderPath, vk::Shad
 }
 
 
+Result ShaderModule::Create(VkDevice hDevice, const ShaderArchive & shaderArchive, const char * pName, vk::ShaderStageFlagBits eStage)
+{
+	vk::ArrayProxy<const uint32_t> pCode = shaderArchive.Find(pName);
+
+	if (pCode.empty() == true)		return Result::eErrorInvalidSPIRVCode;
+
+	return this->Create(hDevice, pCode, eStage);
+}
+
+
 ShaderModule::UniqueHandle::~UniqueHandle() noexcept
 {
 	if (m_StageInfo.module != VK_NULL_HANDLE)
 	{
 		vkDestroyShaderModule(m_hDevice, m_StageInfo.module, nullptr);
 	}
+}
+
+
+/*************************************************************************
+*********************    SpecializationConstants    **********************
+*************************************************************************/
+void SpecializationConstants::Rebuild()
+{
+	m_Data.clear();
+
+	m_MapEntries.clear();
+
+	for (auto & iter : m_Values)
+	{
+		VkSpecializationMapEntry		MapEntry = {};
+		MapEntry.constantID				= iter.first;
+		MapEntry.offset					= static_cast<uint32_t>(m_Data.size());
+		MapEntry.size					= iter.second.size;
+
+		m_MapEntries.push_back(MapEntry);
+
+		m_Data.insert(m_Data.end(), reinterpret_cast<const uint8_t*>(&iter.second.bits), reinterpret_cast<const uint8_t*>(&iter.second.bits) + iter.second.size);
+	}
+
+	m_Info.mapEntryCount		= static_cast<uint32_t>(m_MapEntries.size());
+	m_Info.pMapEntries			= m_MapEntries.data();
+	m_Info.dataSize				= m_Data.size();
+	m_Info.pData				= m_Data.data();
+}
+
+
+uint64_t SpecializationConstants::Hash() const
+{
+	uint64_t hash = HashSeed;
+
+	//	Entries are sorted by constant_id, so equal sets hash equally.
+	for (auto & iter : m_Values)
+	{
+		HashValue(hash, iter.first);
+		HashValue(hash, iter.second.size);
+		HashValue(hash, iter.second.bits);
+	}
+
+	return hash;
+}
+
+
+bool SpecializationConstants::operator==(const SpecializationConstants & Other) const
+{
+	return std::equal(m_Values.begin(), m_Values.end(), Other.m_Values.begin(), Other.m_Values.end(),
+					  [](const auto & lhs, const auto & rhs) { return (lhs.first == rhs.first) && (lhs.second.size == rhs.second.size) && (lhs.second.bits == rhs.second.bits); });
 }
\ No newline at end of file
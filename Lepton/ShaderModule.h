@@ -3,10 +3,107 @@
 *************************************************************************/
 #pragma once
 
-#include "Vulkan.h"
+#include <map>
+#include <cstring>
+#include <type_traits>
+#include "ShaderReflection.h"
 
 namespace Lepton
 {
+	/*********************************************************************
+	*******************    SpecializationConstants    ********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Typed constant_id values applied when a pipeline is created from a shader stage.
+	 */
+	class SpecializationConstants
+	{
+
+	public:
+
+		//!	@brief	Create empty specialization constants.
+		SpecializationConstants() : m_Info{} {}
+
+		//!	@brief	Copy constants (info pointers are rebuilt for the copy).
+		SpecializationConstants(const SpecializationConstants & Other) : m_Values(Other.m_Values), m_Info{} { this->Rebuild(); }
+
+		//!	@brief	Copy constants (info pointers are rebuilt for the copy).
+		SpecializationConstants & operator=(const SpecializationConstants & Other)
+		{
+			m_Values = Other.m_Values;
+
+			this->Rebuild();
+
+			return *this;
+		}
+
+	public:
+
+		//!	@brief	Set a 32-bit or 64-bit scalar for constant_id (bool is stored as VkBool32).
+		template<typename Type> void Set(uint32_t constantID, Type value)
+		{
+			static_assert(std::is_arithmetic_v<Type>, "Specialization constants must be scalars!");
+
+			if constexpr (std::is_same_v<Type, bool>)
+			{
+				this->Set(constantID, static_cast<VkBool32>(value ? VK_TRUE : VK_FALSE));
+			}
+			else
+			{
+				static_assert((sizeof(Type) == 4) || (sizeof(Type) == 8), "Specialization constants must be 32-bit or 64-bit!");
+
+				Value & entry = m_Values[constantID];
+
+				entry.size = sizeof(Type);
+
+				entry.bits = 0;
+
+				std::memcpy(&entry.bits, &value, sizeof(Type));
+
+				this->Rebuild();
+			}
+		}
+
+		//!	@brief	If no constant is set.
+		bool IsEmpty() const { return m_Values.empty(); }
+
+		//!	@brief	Return the specialization info (nullptr if empty), valid while this object is alive and unchanged.
+		const VkSpecializationInfo * GetInfo() const { return m_Values.empty() ? nullptr : &m_Info; }
+
+		//!	@brief	Return 64-bit hash of all constants, independent of the order they were set in.
+		uint64_t Hash() const;
+
+		//!	@brief	If both hold the same constants with the same bits.
+		bool operator==(const SpecializationConstants & Other) const;
+
+	private:
+
+		//!	@brief	Rebuild packed map entries and data.
+		void Rebuild();
+
+	private:
+
+		/**
+		 *	@brief	Raw bits of one constant.
+		 */
+		struct Value
+		{
+			uint32_t		size		= 0;
+			uint64_t		bits		= 0;
+		};
+
+	private:
+
+		std::map<uint32_t, Value>						m_Values;
+
+		std::vector<uint8_t>							m_Data;
+
+		std::vector<VkSpecializationMapEntry>			m_MapEntries;
+
+		VkSpecializationInfo							m_Info;
+	};
+
 	/*********************************************************************
 	*************************    ShaderModule    *************************
 	*********************************************************************/
@@ -20,7 +117,12 @@ namespace Lepton
 	public:
 
 		//!	@brief	Invalidate this resource handle.
-		void Destroy() { m_spUniqueHandle.reset(); }
+		void Destroy()
+		{
+			m_spSpecialization.reset();
+
+			m_spUniqueHandle.reset();
+		}
 
 		//!	@brief	Whether this resource handle is valid.
 		bool IsValid() const { return m_spUniqueHandle != nullptr; }
@@ -29,13 +131,39 @@ namespace Lepton
 		Result Create(VkDevice hDevice, const char * pShaderPath, vk::ShaderStageFlagBits eStage);
 
 		//!	@brief	Create a new shader module.
-		Result Create(VkDevice hDevice, vk::ArrayProxy<uint32_t> pCode, vk::ShaderStageFlagBits eStage);
+		Result Create(VkDevice hDevice, vk::ArrayProxy<const uint32_t> pCode, vk::ShaderStageFlagBits eStage);
+
+		//!	@brief	Create a new shader module directly from the mapped code of an archive entry.
+		Result Create(VkDevice hDevice, const ShaderArchive & shaderArchive, const char * pName, vk::ShaderStageFlagBits eStage);
+
+		//!	@brief	Return resources used by the shader, reflected from its SPIR-V code.
+		const ShaderReflection & GetReflection() const { return m_spUniqueHandle->m_Reflection; }
 
 		//!	@brief	Return device handle.
 		VkDevice GetDeviceHandle() const { return (m_spUniqueHandle != nullptr) ? m_spUniqueHandle->m_hDevice : VK_NULL_HANDLE; }
 
-		//!	@brief	Return shader stage create info for creating graphics pipeline.
-		const VkPipelineShaderStageCreateInfo & GetStageInfo() const { return m_spUniqueHandle->m_StageInfo; }
+		//!	@brief	Return shader stage create info for creating pipelines, including specialization constants.
+		VkPipelineShaderStageCreateInfo GetStageInfo() const
+		{
+			VkPipelineShaderStageCreateInfo StageInfo = m_spUniqueHandle->m_StageInfo;
+
+			StageInfo.pSpecializationInfo = (m_spSpecialization != nullptr) ? m_spSpecialization->GetInfo() : nullptr;
+
+			return StageInfo;
+		}
+
+		//!	@brief	Return a handle to the same module whose stage is specialized with the constants (no new module is created).
+		ShaderModule Specialize(const SpecializationConstants & Constants) const
+		{
+			ShaderModule Specialized = *this;
+
+			Specialized.m_spSpecialization = std::make_shared<const SpecializationConstants>(Constants);
+
+			return Specialized;
+		}
+
+		//!	@brief	Return specialization constants of this handle (nullptr if not specialized).
+		const SpecializationConstants * GetSpecialization() const { return m_spSpecialization.get(); }
 
 	private:
 
@@ -49,7 +177,7 @@ namespace Lepton
 		public:
 
 			//!	@brief	Constructor (handles must be initialized).
-			UniqueHandle(VkDevice, VkShaderModule, vk::ShaderStageFlagBits);
+			UniqueHandle(VkDevice, VkShaderModule, vk::ShaderStageFlagBits, const ShaderReflection&);
 
 			//!	@brief	Where resource will be released.
 			~UniqueHandle() noexcept;
@@ -58,8 +186,11 @@ namespace Lepton
 
 			const VkDevice						m_hDevice;
 			VkPipelineShaderStageCreateInfo		m_StageInfo;
+			const ShaderReflection				m_Reflection;
 		};
 
-		std::shared_ptr<UniqueHandle>			m_spUniqueHandle;
+		std::shared_ptr<UniqueHandle>						m_spUniqueHandle;
+
+		std::shared_ptr<const SpecializationConstants>		m_spSpecialization;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,485 @@
+/*************************************************************************
+*********************    Lepton_ShaderReflection    **********************
+*************************************************************************/
+
+#include <algorithm>
+#include "ShaderReflection.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+*************************    SPIR-V constants    *************************
+*************************************************************************/
+static constexpr uint32_t		SpvMagicNumber						= 0x07230203;
+
+static constexpr uint32_t		SpvOpTypeBool						= 20;
+static constexpr uint32_t		SpvOpTypeInt						= 21;
+static constexpr uint32_t		SpvOpTypeFloat						= 22;
+static constexpr uint32_t		SpvOpTypeVector						= 23;
+static constexpr uint32_t		SpvOpTypeMatrix						= 24;
+static constexpr uint32_t		SpvOpTypeImage						= 25;
+static constexpr uint32_t		SpvOpTypeSampler					= 26;
+static constexpr uint32_t		SpvOpTypeSampledImage				= 27;
+static constexpr uint32_t		SpvOpTypeArray						= 28;
+static constexpr uint32_t		SpvOpTypeRuntimeArray				= 29;
+static constexpr uint32_t		SpvOpTypeStruct						= 30;
+static constexpr uint32_t		SpvOpTypePointer					= 32;
+static constexpr uint32_t		SpvOpConstant						= 43;
+static constexpr uint32_t		SpvOpVariable						= 59;
+static constexpr uint32_t		SpvOpDecorate						= 71;
+static constexpr uint32_t		SpvOpMemberDecorate					= 72;
+static constexpr uint32_t		SpvOpTypeAccelerationStructure		= 5341;
+
+static constexpr uint32_t		SpvDecorationBlock					= 2;
+static constexpr uint32_t		SpvDecorationBufferBlock			= 3;
+static constexpr uint32_t		SpvDecorationArrayStride			= 6;
+static constexpr uint32_t		SpvDecorationMatrixStride			= 7;
+static constexpr uint32_t		SpvDecorationBuiltIn				= 11;
+static constexpr uint32_t		SpvDecorationLocation				= 30;
+static constexpr uint32_t		SpvDecorationBinding				= 33;
+static constexpr uint32_t		SpvDecorationDescriptorSet			= 34;
+static constexpr uint32_t		SpvDecorationOffset					= 35;
+
+static constexpr uint32_t		SpvStorageClassUniformConstant		= 0;
+static constexpr uint32_t		SpvStorageClassInput				= 1;
+static constexpr uint32_t		SpvStorageClassUniform				= 2;
+static constexpr uint32_t		SpvStorageClassPushConstant			= 9;
+static constexpr uint32_t		SpvStorageClassStorageBuffer		= 12;
+
+static constexpr uint32_t		SpvDimBuffer						= 5;
+static constexpr uint32_t		SpvDimSubpassData					= 6;
+
+/**
+ *	@brief	Everything recorded about one SPIR-V result id.
+ */
+struct SpirvId
+{
+	uint32_t					opcode				= 0;
+	uint32_t					typeId				= 0;			//!	Result type of constants and variables.
+	std::vector<uint32_t>		operands;							//!	Words following the result id.
+	uint32_t					set					= UINT32_MAX;
+	uint32_t					binding				= UINT32_MAX;
+	uint32_t					location			= UINT32_MAX;
+	uint32_t					arrayStride			= 0;
+	bool						isBlock				= false;
+	bool						isBufferBlock		= false;
+	bool						isBuiltIn			= false;
+	std::vector<uint32_t>		memberOffsets;
+	std::vector<uint32_t>		memberMatrixStrides;
+};
+
+
+/**
+ *	@brief	Type nesting deeper than this is treated as malformed (also stops cyclic type references).
+ */
+static constexpr uint32_t		MaxTypeDepth		= 64;
+
+static constexpr uint32_t		InvalidTypeSize		= UINT32_MAX;
+
+
+/**
+ *	@brief	Byte size of a type with explicit layout (push constant blocks), InvalidTypeSize if the type is malformed.
+ */
+static uint32_t GetTypeSize(const std::vector<SpirvId> & Ids, uint32_t typeId, uint32_t matrixStride = 0, uint32_t depth = 0)
+{
+	if ((typeId >= Ids.size()) || (depth > MaxTypeDepth))		return InvalidTypeSize;
+
+	const SpirvId & Type = Ids[typeId];
+
+	uint64_t size = InvalidTypeSize;
+
+	switch (Type.opcode)
+	{
+		case SpvOpTypeBool:
+		{
+			size = 4;
+
+			break;
+		}
+		case SpvOpTypeInt:
+		case SpvOpTypeFloat:
+		{
+			if (!Type.operands.empty())		size = Type.operands[0] / 8;
+
+			break;
+		}
+		case SpvOpTypeVector:
+		case SpvOpTypeMatrix:
+		{
+			if (Type.operands.size() < 2)		break;
+
+			const uint32_t elementSize = ((Type.opcode == SpvOpTypeMatrix) && (matrixStride != 0)) ? matrixStride : GetTypeSize(Ids, Type.operands[0], 0, depth + 1);
+
+			if (elementSize != InvalidTypeSize)		size = uint64_t(Type.operands[1]) * elementSize;
+
+			break;
+		}
+		case SpvOpTypeArray:
+		{
+			if ((Type.operands.size() < 2) || (Type.operands[1] >= Ids.size()))		break;
+
+			const SpirvId & Length = Ids[Type.operands[1]];
+
+			const uint64_t length = ((Length.opcode == SpvOpConstant) && !Length.operands.empty()) ? Length.operands[0] : 1;
+
+			const uint32_t elementSize = (Type.arrayStride != 0) ? Type.arrayStride : GetTypeSize(Ids, Type.operands[0], 0, depth + 1);
+
+			if (elementSize != InvalidTypeSize)		size = length * elementSize;
+
+			break;
+		}
+		case SpvOpTypeStruct:
+		{
+			size = 0;
+
+			for (size_t i = 0; i < Type.operands.size(); i++)
+			{
+				uint32_t offset = (i < Type.memberOffsets.size()) ? Type.memberOffsets[i] : 0;
+
+				uint32_t stride = (i < Type.memberMatrixStrides.size()) ? Type.memberMatrixStrides[i] : 0;
+
+				const uint32_t memberSize = GetTypeSize(Ids, Type.operands[i], stride, depth + 1);
+
+				if (memberSize == InvalidTypeSize)		return InvalidTypeSize;
+
+				size = std::max<uint64_t>(size, uint64_t(offset) + memberSize);
+			}
+
+			break;
+		}
+		case 0:
+		{
+			//	Never declared by the module.
+			break;
+		}
+		default:
+		{
+			size = 0;
+
+			break;
+		}
+	}
+
+	return (size < InvalidTypeSize) ? static_cast<uint32_t>(size) : InvalidTypeSize;
+}
+
+
+/**
+ *	@brief	Vertex attribute format of a scalar or vector type (eUndefined if not representable).
+ */
+static vk::Format GetVertexFormat(const std::vector<SpirvId> & Ids, uint32_t typeId)
+{
+	if (typeId >= Ids.size())		return vk::Format::eUndefined;
+
+	const SpirvId & Type = Ids[typeId];
+
+	uint32_t componentCount = 1;
+
+	const SpirvId * pComponent = &Type;
+
+	if (Type.opcode == SpvOpTypeVector)
+	{
+		if ((Type.operands.size() < 2) || (Type.operands[0] >= Ids.size()))		return vk::Format::eUndefined;
+
+		componentCount = Type.operands[1];
+
+		pComponent = &Ids[Type.operands[0]];
+	}
+
+	if ((componentCount < 1) || (componentCount > 4))		return vk::Format::eUndefined;
+
+	static const vk::Format Float16Formats[]	= { vk::Format::eR16Sfloat, vk::Format::eR16G16Sfloat, vk::Format::eR16G16B16Sfloat, vk::Format::eR16G16B16A16Sfloat };
+	static const vk::Format Float32Formats[]	= { vk::Format::eR32Sfloat, vk::Format::eR32G32Sfloat, vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32A32Sfloat };
+	static const vk::Format Float64Formats[]	= { vk::Format::eR64Sfloat, vk::Format::eR64G64Sfloat, vk::Format::eR64G64B64Sfloat, vk::Format::eR64G64B64A64Sfloat };
+	static const vk::Format Sint32Formats[]		= { vk::Format::eR32Sint, vk::Format::eR32G32Sint, vk::Format::eR32G32B32Sint, vk::Format::eR32G32B32A32Sint };
+	static const vk::Format Uint32Formats[]		= { vk::Format::eR32Uint, vk::Format::eR32G32Uint, vk::Format::eR32G32B32Uint, vk::Format::eR32G32B32A32Uint };
+
+	if ((pComponent->opcode == SpvOpTypeFloat) && (pComponent->operands.size() >= 1))
+	{
+		switch (pComponent->operands[0])
+		{
+			case 16:		return Float16Formats[componentCount - 1];
+			case 32:		return Float32Formats[componentCount - 1];
+			case 64:		return Float64Formats[componentCount - 1];
+		}
+	}
+	else if ((pComponent->opcode == SpvOpTypeInt) && (pComponent->operands.size() >= 2) && (pComponent->operands[0] == 32))
+	{
+		return (pComponent->operands[1] != 0) ? Sint32Formats[componentCount - 1] : Uint32Formats[componentCount - 1];
+	}
+
+	return vk::Format::eUndefined;
+}
+
+
+/*************************************************************************
+*************************    ShaderReflection    *************************
+*************************************************************************/
+Result ShaderReflection::Reflect(vk::ArrayProxy<const uint32_t> pCode, vk::ShaderStageFlagBits eStage)
+{
+	m_DescriptorBindings.clear();
+
+	m_VertexInputs.clear();
+
+	m_PushConstantRange = vk::PushConstantRange();
+
+	const uint32_t * pWords = pCode.data();
+
+	const uint32_t wordCount = pCode.size();
+
+	if ((wordCount < 5) || (pWords[0] != SpvMagicNumber))		return Result::eErrorInvalidSPIRVCode;
+
+	//	Every id is defined by an instruction, a bound far beyond the code size can only come from corrupt data.
+	if (pWords[3] > 4ull * wordCount)		return Result::eErrorInvalidSPIRVCode;
+
+	std::vector<SpirvId> Ids(pWords[3]);
+
+	std::vector<uint32_t> VariableIds;
+
+	//	Single pass collects types, constants, variables and decorations.
+	for (uint32_t offset = 5; offset < wordCount;)
+	{
+		const uint32_t instructionSize = pWords[offset] >> 16;
+
+		const uint32_t opcode = pWords[offset] & 0xFFFF;
+
+		if ((instructionSize == 0) || (offset + instructionSize > wordCount))		return Result::eErrorInvalidSPIRVCode;
+
+		const uint32_t * pInstruction = pWords + offset;
+
+		switch (opcode)
+		{
+			case SpvOpDecorate:
+			{
+				if ((instructionSize < 3) || (pInstruction[1] >= Ids.size()))		return Result::eErrorInvalidSPIRVCode;
+
+				SpirvId & Target = Ids[pInstruction[1]];
+
+				const uint32_t literal = (instructionSize > 3) ? pInstruction[3] : 0;
+
+				switch (pInstruction[2])
+				{
+					case SpvDecorationBlock:				Target.isBlock = true;				break;
+					case SpvDecorationBufferBlock:			Target.isBufferBlock = true;		break;
+					case SpvDecorationBuiltIn:				Target.isBuiltIn = true;			break;
+					case SpvDecorationArrayStride:			Target.arrayStride = literal;		break;
+					case SpvDecorationLocation:				Target.location = literal;			break;
+					case SpvDecorationBinding:				Target.binding = literal;			break;
+					case SpvDecorationDescriptorSet:		Target.set = literal;				break;
+				}
+
+				break;
+			}
+			case SpvOpMemberDecorate:
+			{
+				if ((instructionSize < 5) || (pInstruction[1] >= Ids.size()))		break;
+
+				SpirvId & Target = Ids[pInstruction[1]];
+
+				const uint32_t member = pInstruction[2];
+
+				//	Each member takes a word of the struct declaration.
+				if (member >= wordCount)		return Result::eErrorInvalidSPIRVCode;
+
+				if (pInstruction[3] == SpvDecorationOffset)
+				{
+					if (Target.memberOffsets.size() <= member)				Target.memberOffsets.resize(member + 1, 0);
+
+					Target.memberOffsets[member] = pInstruction[4];
+				}
+				else if (pInstruction[3] == SpvDecorationMatrixStride)
+				{
+					if (Target.memberMatrixStrides.size() <= member)		Target.memberMatrixStrides.resize(member + 1, 0);
+
+					Target.memberMatrixStrides[member] = pInstruction[4];
+				}
+
+				break;
+			}
+			case SpvOpTypeBool:
+			case SpvOpTypeInt:
+			case SpvOpTypeFloat:
+			case SpvOpTypeVector:
+			case SpvOpTypeMatrix:
+			case SpvOpTypeImage:
+			case SpvOpTypeSampler:
+			case SpvOpTypeSampledImage:
+			case SpvOpTypeArray:
+			case SpvOpTypeRuntimeArray:
+			case SpvOpTypeStruct:
+			case SpvOpTypePointer:
+			case SpvOpTypeAccelerationStructure:
+			{
+				if ((instructionSize < 2) || (pInstruction[1] >= Ids.size()))		return Result::eErrorInvalidSPIRVCode;
+
+				Ids[pInstruction[1]].opcode = opcode;
+
+				Ids[pInstruction[1]].operands.assign(pInstruction + 2, pInstruction + instructionSize);
+
+				break;
+			}
+			case SpvOpConstant:
+			case SpvOpVariable:
+			{
+				if ((instructionSize < 4) || (pInstruction[2] >= Ids.size()))		return Result::eErrorInvalidSPIRVCode;
+
+				Ids[pInstruction[2]].opcode = opcode;
+
+				Ids[pInstruction[2]].typeId = pInstruction[1];
+
+				Ids[pInstruction[2]].operands.assign(pInstruction + 3, pInstruction + instructionSize);
+
+				if (opcode == SpvOpVariable)		VariableIds.push_back(pInstruction[2]);
+
+				break;
+			}
+		}
+
+		offset += instructionSize;
+	}
+
+	//	Validate every id the second pass dereferences, so malformed code can't index out of range.
+	auto IsType = [&Ids](uint32_t id, uint32_t opcode) { return (id < Ids.size()) && (Ids[id].opcode == opcode); };
+
+	uint32_t pushConstantBegin = UINT32_MAX;
+
+	for (auto variableId : VariableIds)
+	{
+		const SpirvId & Variable = Ids[variableId];
+
+		if (!IsType(Variable.typeId, SpvOpTypePointer) || (Ids[Variable.typeId].operands.size() < 2))		continue;
+
+		const uint32_t storageClass = Variable.operands[0];
+
+		uint32_t typeId = Ids[Variable.typeId].operands[1];
+
+		if (storageClass == SpvStorageClassPushConstant)
+		{
+			if (!IsType(typeId, SpvOpTypeStruct))		continue;
+
+			const SpirvId & Block = Ids[typeId];
+
+			for (auto offset : Block.memberOffsets)		pushConstantBegin = std::min(pushConstantBegin, offset);
+
+			const uint32_t blockSize = GetTypeSize(Ids, typeId);
+
+			m_PushConstantRange.stageFlags		= eStage;
+			m_PushConstantRange.offset			= (pushConstantBegin != UINT32_MAX) ? pushConstantBegin : 0;
+
+			if ((blockSize == InvalidTypeSize) || (blockSize < m_PushConstantRange.offset))		return Result::eErrorInvalidSPIRVCode;
+
+			m_PushConstantRange.size			= blockSize - m_PushConstantRange.offset;
+		}
+		else if ((storageClass == SpvStorageClassInput) && (eStage == vk::ShaderStageFlagBits::eVertex))
+		{
+			if (Variable.isBuiltIn || (Variable.location == UINT32_MAX) || (typeId >= Ids.size()))		continue;
+
+			//	Matrices take one location per column.
+			uint32_t columnCount = 1;
+
+			if (Ids[typeId].opcode == SpvOpTypeMatrix)
+			{
+				if (Ids[typeId].operands.size() < 2)		return Result::eErrorInvalidSPIRVCode;
+
+				columnCount = Ids[typeId].operands[1];
+
+				if ((columnCount < 2) || (columnCount > 4))		return Result::eErrorInvalidSPIRVCode;
+
+				typeId = Ids[typeId].operands[0];
+			}
+
+			VertexInput			Input;
+			Input.eFormat		= GetVertexFormat(Ids, typeId);
+			Input.size			= GetTypeSize(Ids, typeId);
+
+			if ((Input.eFormat == vk::Format::eUndefined) || (Input.size == InvalidTypeSize))		continue;
+
+			for (uint32_t i = 0; i < columnCount; i++)
+			{
+				Input.location = Variable.location + i;
+
+				m_VertexInputs.push_back(Input);
+			}
+		}
+		else if ((storageClass == SpvStorageClassUniformConstant) || (storageClass == SpvStorageClassUniform) || (storageClass == SpvStorageClassStorageBuffer))
+		{
+			if ((Variable.set == UINT32_MAX) || (Variable.binding == UINT32_MAX))		continue;
+
+			DescriptorBinding			Binding;
+			Binding.set					= Variable.set;
+			Binding.binding				= Variable.binding;
+			Binding.descriptorCount		= 1;
+			Binding.eStages				= eStage;
+
+			for (uint32_t depth = 0; IsType(typeId, SpvOpTypeArray) || IsType(typeId, SpvOpTypeRuntimeArray); depth++)
+			{
+				const SpirvId & Array = Ids[typeId];
+
+				if ((depth > MaxTypeDepth) || Array.operands.empty())		return Result::eErrorInvalidSPIRVCode;
+
+				if (Array.opcode == SpvOpTypeArray)
+				{
+					if (Array.operands.size() < 2)		return Result::eErrorInvalidSPIRVCode;
+
+					if (IsType(Array.operands[1], SpvOpConstant) && !Ids[Array.operands[1]].operands.empty())
+					{
+						Binding.descriptorCount *= Ids[Array.operands[1]].operands[0];
+					}
+				}
+
+				typeId = Array.operands[0];
+			}
+
+			if (typeId >= Ids.size())		continue;
+
+			const SpirvId & Type = Ids[typeId];
+
+			if (storageClass == SpvStorageClassStorageBuffer)
+			{
+				Binding.eType = vk::DescriptorType::eStorageBuffer;
+			}
+			else if (storageClass == SpvStorageClassUniform)
+			{
+				Binding.eType = Type.isBufferBlock ? vk::DescriptorType::eStorageBuffer : vk::DescriptorType::eUniformBuffer;
+			}
+			else if (Type.opcode == SpvOpTypeSampler)
+			{
+				Binding.eType = vk::DescriptorType::eSampler;
+			}
+			else if (Type.opcode == SpvOpTypeSampledImage)
+			{
+				Binding.eType = vk::DescriptorType::eCombinedImageSampler;
+			}
+			else if (Type.opcode == SpvOpTypeAccelerationStructure)
+			{
+				Binding.eType = vk::DescriptorType::eAccelerationStructureNV;
+			}
+			else if ((Type.opcode == SpvOpTypeImage) && (Type.operands.size() >= 6))
+			{
+				//	Operands: sampled type, dim, depth, arrayed, MS, sampled (1 = sampled, 2 = storage), format.
+				const uint32_t dim = Type.operands[1];
+
+				const bool isStorage = (Type.operands[5] == 2);
+
+				if (dim == SpvDimSubpassData)			Binding.eType = vk::DescriptorType::eInputAttachment;
+				else if (dim == SpvDimBuffer)			Binding.eType = isStorage ? vk::DescriptorType::eStorageTexelBuffer : vk::DescriptorType::eUniformTexelBuffer;
+				else									Binding.eType = isStorage ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage;
+			}
+			else
+			{
+				continue;
+			}
+
+			m_DescriptorBindings.push_back(Binding);
+		}
+	}
+
+	std::sort(m_DescriptorBindings.begin(), m_DescriptorBindings.end(), [](const DescriptorBinding & a, const DescriptorBinding & b)
+	{
+		return (a.set != b.set) ? (a.set < b.set) : (a.binding < b.binding);
+	});
+
+	std::sort(m_VertexInputs.begin(), m_VertexInputs.end(), [](const VertexInput & a, const VertexInput & b) { return a.location < b.location; });
+
+	return Result::eSuccess;
+}
\ No newline at end of file
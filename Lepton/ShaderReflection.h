@@ -0,0 +1,66 @@
+/*************************************************************************
+*********************    Lepton_ShaderReflection    **********************
+*************************************************************************/
+#pragma once
+
+#include "Vulkan.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	***********************    ShaderReflection    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Resource interface of one SPIR-V module: descriptor bindings, push constants and vertex inputs.
+	 */
+	class ShaderReflection
+	{
+
+	public:
+
+		/**
+		 *	@brief	Descriptor binding used by the shader.
+		 */
+		struct DescriptorBinding
+		{
+			uint32_t					set					= 0;
+			uint32_t					binding				= 0;
+			vk::DescriptorType			eType				= vk::DescriptorType::eUniformBuffer;
+			uint32_t					descriptorCount		= 1;		//!	Runtime arrays report 1.
+			vk::ShaderStageFlags		eStages;
+		};
+
+		/**
+		 *	@brief	Vertex shader input occupying one location.
+		 */
+		struct VertexInput
+		{
+			uint32_t					location			= 0;
+			vk::Format					eFormat				= vk::Format::eUndefined;
+			uint32_t					size				= 0;		//!	Bytes of one element.
+		};
+
+	public:
+
+		//!	@brief	Parse SPIR-V words, eStage is recorded on every binding and the push constant range.
+		Result Reflect(vk::ArrayProxy<const uint32_t> pCode, vk::ShaderStageFlagBits eStage);
+
+		//!	@brief	Return descriptor bindings sorted by set and binding.
+		const std::vector<DescriptorBinding> & GetDescriptorBindings() const { return m_DescriptorBindings; }
+
+		//!	@brief	Return vertex inputs sorted by location (vertex stage only).
+		const std::vector<VertexInput> & GetVertexInputs() const { return m_VertexInputs; }
+
+		//!	@brief	Return push constant range (size is 0 if the shader has no push constant block).
+		const vk::PushConstantRange & GetPushConstantRange() const { return m_PushConstantRange; }
+
+	private:
+
+		std::vector<DescriptorBinding>		m_DescriptorBindings;
+
+		std::vector<VertexInput>			m_VertexInputs;
+
+		vk::PushConstantRange				m_PushConstantRange;
+	};
+}
\ No newline at end of file
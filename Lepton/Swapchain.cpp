@@ -2,6 +2,7 @@
 *************************    Lepton_Swapchain    *************************
 *************************************************************************/
 
+#include "Commands.h"
 #include "Swapchain.h"
 
 using namespace Lepton;
@@ -106,12 +107,14 @@ uint32_t Swapchain::AcquireNextImageIndex(VkSemaphore hSemaphore, VkFence hFence
 }
 
 
-Result Swapchain::Present(VkQueue hQueue, vk::ArrayProxy<VkSemaphore> waitSemaphores)
+Result Swapchain::Present(CommandQueue * pCommandQueue, vk::ArrayProxy<VkSemaphore> waitSemaphores)
 {
+	if (pCommandQueue == nullptr)		return Result::eErrorInvalidDeviceHandle;
+
 	m_PresentInfo.pWaitSemaphores		= waitSemaphores.data();
 	m_PresentInfo.waitSemaphoreCount	= waitSemaphores.size();
 
-	return LAVA_RESULT_CAST(vkQueuePresentKHR(hQueue, &m_PresentInfo));
+	return pCommandQueue->Present(m_PresentInfo);
 }
 
 
@@ -30,8 +30,8 @@ namespace Lepton
 
 	public:
 
-		//!	@brief	Queue an image for presentation.
-		Result Present(VkQueue hQueue, vk::ArrayProxy<VkSemaphore> waitSemaphores = nullptr);
+		//!	@brief	Queue an image for presentation, serialized with submissions to the same queue.
+		Result Present(CommandQueue * pCommandQueue, vk::ArrayProxy<VkSemaphore> waitSemaphores = nullptr);
 
 		//!	@brief	Reconstruct swap-chain.
 		Result Reconstruct(VkDevice hDevice, VkSurfaceKHR hSurface, vk::PresentModeKHR ePresentMode, VkExtent2D imageExtent, uint32_t minImageCount);
@@ -126,6 +126,131 @@ Semaphore::~Semaphore()
 }
 
 
+/*************************************************************************
+************************    TimelineSemaphore    *************************
+*************************************************************************/
+TimelineSemaphore::TimelineSemaphore()
+	: m_hDevice(VK_NULL_HANDLE), m_hSemaphore(VK_NULL_HANDLE),
+	m_pfnSignalSemaphore(nullptr), m_pfnWaitSemaphores(nullptr), m_pfnGetSemaphoreCounterValue(nullptr)
+{
+
+}
+
+
+TimelineSemaphore::TimelineSemaphore(VkDevice hDevice, uint64_t initialValue) : TimelineSemaphore()
+{
+	this->Create(hDevice, initialValue);
+}
+
+
+Result TimelineSemaphore::Create(VkDevice hDevice, uint64_t initialValue)
+{
+	if (hDevice == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	PFN_vkSignalSemaphoreKHR				pfnSignalSemaphore = nullptr;
+	PFN_vkWaitSemaphoresKHR					pfnWaitSemaphores = nullptr;
+	PFN_vkGetSemaphoreCounterValueKHR		pfnGetSemaphoreCounterValue = nullptr;
+
+	pfnSignalSemaphore				= (PFN_vkSignalSemaphoreKHR)vkGetDeviceProcAddr(hDevice, "vkSignalSemaphoreKHR");
+	pfnWaitSemaphores				= (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(hDevice, "vkWaitSemaphoresKHR");
+	pfnGetSemaphoreCounterValue		= (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(hDevice, "vkGetSemaphoreCounterValueKHR");
+
+	if (!pfnSignalSemaphore)					return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnWaitSemaphores)						return Result::eErrorFailedToGetProcessAddress;
+	if (!pfnGetSemaphoreCounterValue)			return Result::eErrorFailedToGetProcessAddress;
+
+	VkSemaphoreTypeCreateInfoKHR		TypeCreateInfo = {};
+	TypeCreateInfo.sType				= VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+	TypeCreateInfo.pNext				= nullptr;
+	TypeCreateInfo.semaphoreType		= VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+	TypeCreateInfo.initialValue			= initialValue;
+
+	VkSemaphoreCreateInfo		CreateInfo;
+	CreateInfo.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	CreateInfo.pNext			= &TypeCreateInfo;
+	CreateInfo.flags			= 0;
+
+	VkSemaphore hSemaphore = VK_NULL_HANDLE;
+
+	Result eResult = LAVA_RESULT_CAST(vkCreateSemaphore(hDevice, &CreateInfo, nullptr, &hSemaphore));
+
+	if (eResult == Result::eSuccess)
+	{
+		this->Destroy();
+
+		m_hDevice = hDevice;
+
+		m_hSemaphore = hSemaphore;
+
+		m_pfnSignalSemaphore = pfnSignalSemaphore;
+
+		m_pfnWaitSemaphores = pfnWaitSemaphores;
+
+		m_pfnGetSemaphoreCounterValue = pfnGetSemaphoreCounterValue;
+	}
+
+	return eResult;
+}
+
+
+Result TimelineSemaphore::Signal(uint64_t value)
+{
+	VkSemaphoreSignalInfoKHR	SignalInfo = {};
+	SignalInfo.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+	SignalInfo.pNext			= nullptr;
+	SignalInfo.semaphore		= m_hSemaphore;
+	SignalInfo.value			= value;
+
+	return LAVA_RESULT_CAST(m_pfnSignalSemaphore(m_hDevice, &SignalInfo));
+}
+
+
+Result TimelineSemaphore::Wait(uint64_t value, uint64_t timeout) const
+{
+	VkSemaphoreWaitInfoKHR		WaitInfo = {};
+	WaitInfo.sType				= VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+	WaitInfo.pNext				= nullptr;
+	WaitInfo.flags				= 0;
+	WaitInfo.semaphoreCount		= 1;
+	WaitInfo.pSemaphores		= &m_hSemaphore;
+	WaitInfo.pValues			= &value;
+
+	return LAVA_RESULT_CAST(m_pfnWaitSemaphores(m_hDevice, &WaitInfo, timeout));
+}
+
+
+uint64_t TimelineSemaphore::GetValue() const
+{
+	uint64_t value = 0;
+
+	if (m_pfnGetSemaphoreCounterValue(m_hDevice, m_hSemaphore, &value) != VK_SUCCESS)
+	{
+		value = UINT64_MAX;
+	}
+
+	return value;
+}
+
+
+void TimelineSemaphore::Destroy()
+{
+	if (m_hSemaphore != VK_NULL_HANDLE)
+	{
+		vkDestroySemaphore(m_hDevice, m_hSemaphore, nullptr);
+
+		m_hSemaphore = VK_NULL_HANDLE;
+
+		m_hDevice = VK_NULL_HANDLE;
+	}
+}
+
+
+TimelineSemaphore::~TimelineSemaphore()
+{
+	this->Destroy();
+}
+
+
 /*************************************************************************
 ******************************    Event    *******************************
 *************************************************************************/
@@ -78,6 +78,84 @@ namespace Lepton
 		void Destroy();
 	};
 
+	/*********************************************************************
+	**********************    TimelineSemaphore    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Wrapper for Vulkan timeline semaphore (VK_KHR_timeline_semaphore, timelineSemaphore feature must be enabled).
+	 */
+	class TimelineSemaphore
+	{
+		LAVA_NONCOPYABLE(TimelineSemaphore)
+
+	public:
+
+		//!	@brief	Create timeline semaphore object.
+		TimelineSemaphore();
+
+		//!	@brief	Create and initialize immediately.
+		explicit TimelineSemaphore(VkDevice hDevice, uint64_t initialValue = 0);
+
+		//!	@brief	Destroy timeline semaphore object.
+		~TimelineSemaphore();
+
+	public:
+
+		//!	@brief	Convert to VkSemaphore.
+		operator VkSemaphore() const { return m_hSemaphore; }
+
+		//!	@brief	Return Vulkan type of this object.
+		VkSemaphore Handle() const { return m_hSemaphore; }
+
+		//!	@brief	Return VkDevice handle.
+		VkDevice GetDeviceHandle() const { return m_hDevice; }
+
+		//!	@brief	If semaphore handle is valid.
+		bool IsValid() const { return m_hSemaphore != VK_NULL_HANDLE; }
+
+		//!	@brief	Create a new timeline semaphore object.
+		Result Create(VkDevice hDevice, uint64_t initialValue = 0);
+
+		//!	@brief	Set the counter from the host (value must be greater than the current one).
+		Result Signal(uint64_t value);
+
+		//!	@brief	Wait for the counter to reach value.
+		Result Wait(uint64_t value, uint64_t timeout = LAVA_DEFAULT_TIMEOUT) const;
+
+		//!	@brief	Return the current counter value (UINT64_MAX on device lost).
+		uint64_t GetValue() const;
+
+		//!	@brief	Destroy the semaphore.
+		void Destroy();
+
+	private:
+
+		VkDevice								m_hDevice;
+
+		VkSemaphore								m_hSemaphore;
+
+		PFN_vkSignalSemaphoreKHR				m_pfnSignalSemaphore;
+
+		PFN_vkWaitSemaphoresKHR					m_pfnWaitSemaphores;
+
+		PFN_vkGetSemaphoreCounterValueKHR		m_pfnGetSemaphoreCounterValue;
+	};
+
+	/*********************************************************************
+	************************    SemaphoreSubmit    ***********************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Semaphore operation of a queue submission (value is ignored for binary semaphores).
+	 */
+	struct SemaphoreSubmit
+	{
+		VkSemaphore						hSemaphore		= VK_NULL_HANDLE;
+		uint64_t						value			= 0;
+		vk::PipelineStageFlags			eStageMask		= vk::PipelineStageFlagBits::eAllCommands;		//!	Only used by wait operations.
+	};
+
 	/*********************************************************************
 	****************************    Event    *****************************
 	*********************************************************************/
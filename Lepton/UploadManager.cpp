@@ -0,0 +1,763 @@
+/*************************************************************************
+***********************    Lepton_UploadManager    ***********************
+*************************************************************************/
+
+#include <tuple>
+#include <numeric>
+#include <algorithm>
+#include "Commands.h"
+#include "LogicalDevice.h"
+#include "UploadManager.h"
+
+using namespace Lepton;
+
+/*************************************************************************
+**************************    UploadManager    ***************************
+*************************************************************************/
+UploadManager::UploadManager()
+	: m_hDevice(VK_NULL_HANDLE), m_pQueue(nullptr), m_pCommandPool(nullptr),
+	m_DstFamilyIndex(LAVA_INVALID_INDEX), m_SubmittedValue(0), m_CompletedValue(0)
+{
+
+}
+
+
+Result UploadManager::Create(const LogicalDevice * pLogicalDevice, CommandQueue * pTransferQueue, uint32_t dstFamilyIndex, VkDeviceSize stagingSize)
+{
+	if (pLogicalDevice == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pLogicalDevice->IsReady())			return Result::eErrorInvalidDeviceHandle;
+	if (pTransferQueue == nullptr)			return Result::eErrorInvalidDeviceHandle;
+	if (!pTransferQueue->IsReady())			return Result::eErrorInvalidDeviceHandle;
+
+	this->Destroy();
+
+	CommandPool * pCommandPool = pTransferQueue->CreateCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient);
+
+	if (pCommandPool == nullptr)			return Result::eErrorOutOfDeviceMemory;
+
+	Result eResult = m_StagingRing.Create(pLogicalDevice, stagingSize);
+
+	if (eResult != Result::eSuccess)
+	{
+		pTransferQueue->DestroyCommandPool(pCommandPool);
+
+		return eResult;
+	}
+
+	m_hDevice = pLogicalDevice->Handle();
+
+	m_pQueue = pTransferQueue;
+
+	m_pCommandPool = pCommandPool;
+
+	m_DstFamilyIndex = dstFamilyIndex;
+
+	return Result::eSuccess;
+}
+
+
+RingBuffer::Allocation UploadManager::AllocateStaging(VkDeviceSize size, VkDeviceSize alignment)
+{
+	RingBuffer::Allocation allocation = m_StagingRing.Allocate(size, alignment);
+
+	while (!allocation)
+	{
+		//	Ring is full: hand the queued copies to the device and wait for the oldest batch.
+		if (!m_BufferCopies.empty() || !m_ImageCopies.empty())
+		{
+			if (this->SubmitLocked(nullptr) != Result::eSuccess)		break;
+		}
+
+		if (m_PendingBatches.empty())		break;
+
+		m_PendingBatches.front()->fence.Wait();
+
+		this->Retire();
+
+		allocation = m_StagingRing.Allocate(size, alignment);
+	}
+
+	return allocation;
+}
+
+
+Result UploadManager::Upload(VkBuffer hDstBuffer, VkDeviceSize dstOffset, const void * pHostData, VkDeviceSize size)
+{
+	if (m_pQueue == nullptr)				return Result::eErrorInvalidDeviceHandle;
+	if (hDstBuffer == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	//	Split large uploads so that a single copy never needs more than half of the ring.
+	const VkDeviceSize chunkSize = m_StagingRing.Bytes() / 2;
+
+	for (VkDeviceSize offset = 0; offset < size; offset += chunkSize)
+	{
+		const VkDeviceSize bytes = std::min(chunkSize, size - offset);
+
+		RingBuffer::Allocation staging = this->AllocateStaging(bytes, 0);
+
+		if (!staging)		return Result::eErrorOutOfDeviceMemory;
+
+		std::memcpy(staging.pData, static_cast<const uint8_t*>(pHostData) + offset, static_cast<size_t>(bytes));
+
+		m_BufferCopies.push_back({ hDstBuffer, { staging.offset, dstOffset + offset, bytes } });
+	}
+
+	return Result::eSuccess;
+}
+
+
+/**
+ *	@brief	Bytes and texel extent of one block of a format (as copied, per aspect for depth/stencil).
+ */
+struct TexelBlock
+{
+	VkFormat		eLastFormat;
+	uint32_t		size;
+	uint32_t		width;
+	uint32_t		height;
+};
+
+//	Core formats grouped by block, each entry covers the formats up to and including eLastFormat.
+static constexpr TexelBlock s_TexelBlocks[] =
+{
+	{ VK_FORMAT_R4G4_UNORM_PACK8,					1,		1,		1 },
+	{ VK_FORMAT_A1R5G5B5_UNORM_PACK16,				2,		1,		1 },
+	{ VK_FORMAT_R8_SRGB,							1,		1,		1 },
+	{ VK_FORMAT_R8G8_SRGB,							2,		1,		1 },
+	{ VK_FORMAT_B8G8R8_SRGB,						3,		1,		1 },
+	{ VK_FORMAT_A2B10G10R10_SINT_PACK32,			4,		1,		1 },
+	{ VK_FORMAT_R16_SFLOAT,							2,		1,		1 },
+	{ VK_FORMAT_R16G16_SFLOAT,						4,		1,		1 },
+	{ VK_FORMAT_R16G16B16_SFLOAT,					6,		1,		1 },
+	{ VK_FORMAT_R16G16B16A16_SFLOAT,				8,		1,		1 },
+	{ VK_FORMAT_R32_SFLOAT,							4,		1,		1 },
+	{ VK_FORMAT_R32G32_SFLOAT,						8,		1,		1 },
+	{ VK_FORMAT_R32G32B32_SFLOAT,					12,		1,		1 },
+	{ VK_FORMAT_R32G32B32A32_SFLOAT,				16,		1,		1 },
+	{ VK_FORMAT_R64_SFLOAT,							8,		1,		1 },
+	{ VK_FORMAT_R64G64_SFLOAT,						16,		1,		1 },
+	{ VK_FORMAT_R64G64B64_SFLOAT,					24,		1,		1 },
+	{ VK_FORMAT_R64G64B64A64_SFLOAT,				32,		1,		1 },
+	{ VK_FORMAT_E5B9G9R9_UFLOAT_PACK32,				4,		1,		1 },
+	{ VK_FORMAT_D16_UNORM,							2,		1,		1 },
+	{ VK_FORMAT_D32_SFLOAT,							4,		1,		1 },
+	{ VK_FORMAT_S8_UINT,							1,		1,		1 },
+	{ VK_FORMAT_D16_UNORM_S8_UINT,					2,		1,		1 },
+	{ VK_FORMAT_D32_SFLOAT_S8_UINT,					4,		1,		1 },
+	{ VK_FORMAT_BC1_RGBA_SRGB_BLOCK,				8,		4,		4 },
+	{ VK_FORMAT_BC3_SRGB_BLOCK,						16,		4,		4 },
+	{ VK_FORMAT_BC4_SNORM_BLOCK,					8,		4,		4 },
+	{ VK_FORMAT_BC7_SRGB_BLOCK,						16,		4,		4 },
+	{ VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK,			8,		4,		4 },
+	{ VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,			16,		4,		4 },
+	{ VK_FORMAT_EAC_R11_SNORM_BLOCK,				8,		4,		4 },
+	{ VK_FORMAT_EAC_R11G11_SNORM_BLOCK,				16,		4,		4 },
+	{ VK_FORMAT_ASTC_4x4_SRGB_BLOCK,				16,		4,		4 },
+	{ VK_FORMAT_ASTC_5x4_SRGB_BLOCK,				16,		5,		4 },
+	{ VK_FORMAT_ASTC_5x5_SRGB_BLOCK,				16,		5,		5 },
+	{ VK_FORMAT_ASTC_6x5_SRGB_BLOCK,				16,		6,		5 },
+	{ VK_FORMAT_ASTC_6x6_SRGB_BLOCK,				16,		6,		6 },
+	{ VK_FORMAT_ASTC_8x5_SRGB_BLOCK,				16,		8,		5 },
+	{ VK_FORMAT_ASTC_8x6_SRGB_BLOCK,				16,		8,		6 },
+	{ VK_FORMAT_ASTC_8x8_SRGB_BLOCK,				16,		8,		8 },
+	{ VK_FORMAT_ASTC_10x5_SRGB_BLOCK,				16,		10,		5 },
+	{ VK_FORMAT_ASTC_10x6_SRGB_BLOCK,				16,		10,		6 },
+	{ VK_FORMAT_ASTC_10x8_SRGB_BLOCK,				16,		10,		8 },
+	{ VK_FORMAT_ASTC_10x10_SRGB_BLOCK,				16,		10,		10 },
+	{ VK_FORMAT_ASTC_12x10_SRGB_BLOCK,				16,		12,		10 },
+	{ VK_FORMAT_ASTC_12x12_SRGB_BLOCK,				16,		12,		12 },
+};
+
+
+//!	@brief	Return the block of the format as copied for the aspect, nullptr for unsupported (e.g. multi-planar) formats.
+static const TexelBlock * GetTexelBlock(vk::Format eFormat, VkImageAspectFlags aspectMask)
+{
+	static constexpr TexelBlock StencilBlock = { VK_FORMAT_S8_UINT, 1, 1, 1 };
+
+	const VkFormat format = static_cast<VkFormat>(eFormat);
+
+	if ((format <= VK_FORMAT_UNDEFINED) || (format > VK_FORMAT_ASTC_12x12_SRGB_BLOCK))		return nullptr;
+
+	//	The stencil aspect of combined depth/stencil formats is always copied as tightly packed bytes.
+	if ((aspectMask == VK_IMAGE_ASPECT_STENCIL_BIT) && (format >= VK_FORMAT_D16_UNORM_S8_UINT) && (format <= VK_FORMAT_D32_SFLOAT_S8_UINT))
+	{
+		return &StencilBlock;
+	}
+
+	for (auto & Block : s_TexelBlocks)
+	{
+		if (format <= Block.eLastFormat)		return &Block;
+	}
+
+	return nullptr;
+}
+
+
+Result UploadManager::Upload(VkImage hDstImage, vk::Format eFormat, const VkImageSubresourceLayers & subresource, VkOffset3D offset, VkExtent3D extent,
+							 const void * pHostData, VkDeviceSize size, vk::ImageLayout eFinalLayout, vk::ImageLayout eCurrentLayout)
+{
+	if (m_pQueue == nullptr)				return Result::eErrorInvalidDeviceHandle;
+	if (hDstImage == VK_NULL_HANDLE)		return Result::eErrorInvalidDeviceHandle;
+
+	const TexelBlock * pBlock = GetTexelBlock(eFormat, subresource.aspectMask);
+
+	if (pBlock == nullptr)					return Result::eErrorFormatNotSupported;
+
+	const VkDeviceSize blocksX = (extent.width + pBlock->width - 1) / pBlock->width;
+	const VkDeviceSize blocksY = (extent.height + pBlock->height - 1) / pBlock->height;
+	const VkDeviceSize rowBytes = blocksX * pBlock->size;
+	const VkDeviceSize sliceBytes = rowBytes * blocksY;
+	const VkDeviceSize layerBytes = sliceBytes * extent.depth;
+
+	if (size < layerBytes * subresource.layerCount)		return Result::eErrorInitializationFailed;
+
+	//	bufferOffset must be a multiple of 4 and of the texel block size.
+	const VkDeviceSize alignment = std::lcm<VkDeviceSize>(4, pBlock->size);
+
+	const VkImageLayout eOldLayout = static_cast<VkImageLayout>(eCurrentLayout);
+
+	const VkImageLayout eNewLayout = static_cast<VkImageLayout>(eFinalLayout);
+
+	const uint8_t * pBytes = static_cast<const uint8_t*>(pHostData);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	//	Same bound as buffer uploads: a single copy never needs more than half of the ring.
+	const VkDeviceSize chunkSize = m_StagingRing.Bytes() / 2;
+
+	if (rowBytes > chunkSize)		return Result::eErrorOutOfDeviceMemory;
+
+	if (layerBytes * subresource.layerCount <= chunkSize)
+	{
+		return this->QueueImageCopy(hDstImage, subresource, offset, extent, pBytes, layerBytes * subresource.layerCount, alignment, eOldLayout, eNewLayout);
+	}
+
+	//	Split into whole layers, then depth slices, then runs of block rows.
+	for (uint32_t layer = 0; layer < subresource.layerCount; layer++)
+	{
+		VkImageSubresourceLayers LayerSubresource = subresource;
+		LayerSubresource.baseArrayLayer = subresource.baseArrayLayer + layer;
+		LayerSubresource.layerCount = 1;
+
+		const uint8_t * pLayer = pBytes + layer * layerBytes;
+
+		if (layerBytes <= chunkSize)
+		{
+			Result eResult = this->QueueImageCopy(hDstImage, LayerSubresource, offset, extent, pLayer, layerBytes, alignment, eOldLayout, eNewLayout);
+
+			if (eResult != Result::eSuccess)		return eResult;
+
+			continue;
+		}
+
+		for (uint32_t z = 0; z < extent.depth; z++)
+		{
+			const uint8_t * pSlice = pLayer + z * sliceBytes;
+
+			const VkDeviceSize rowsPerCopy = std::min(blocksY, chunkSize / rowBytes);
+
+			for (VkDeviceSize row = 0; row < blocksY; row += rowsPerCopy)
+			{
+				const VkDeviceSize rows = std::min(rowsPerCopy, blocksY - row);
+
+				const uint32_t texelY = static_cast<uint32_t>(row * pBlock->height);
+
+				const VkOffset3D RegionOffset = { offset.x, offset.y + static_cast<int32_t>(texelY), offset.z + static_cast<int32_t>(z) };
+
+				const VkExtent3D RegionExtent = { extent.width, std::min(static_cast<uint32_t>(rows * pBlock->height), extent.height - texelY), 1 };
+
+				Result eResult = this->QueueImageCopy(hDstImage, LayerSubresource, RegionOffset, RegionExtent, pSlice + row * rowBytes, rows * rowBytes, alignment, eOldLayout, eNewLayout);
+
+				if (eResult != Result::eSuccess)		return eResult;
+			}
+		}
+	}
+
+	return Result::eSuccess;
+}
+
+
+Result UploadManager::QueueImageCopy(VkImage hDstImage, const VkImageSubresourceLayers & subresource, VkOffset3D offset, VkExtent3D extent,
+									 const void * pHostData, VkDeviceSize size, VkDeviceSize alignment, VkImageLayout eCurrentLayout, VkImageLayout eFinalLayout)
+{
+	RingBuffer::Allocation staging = this->AllocateStaging(size, alignment);
+
+	if (!staging)		return Result::eErrorOutOfDeviceMemory;
+
+	std::memcpy(staging.pData, pHostData, static_cast<size_t>(size));
+
+	ImageCopy				Copy = {};
+	Copy.hDstImage			= hDstImage;
+	Copy.eCurrentLayout		= eCurrentLayout;
+	Copy.eFinalLayout		= eFinalLayout;
+	Copy.region				= { staging.offset, 0, 0, subresource, offset, extent };
+
+	m_ImageCopies.push_back(Copy);
+
+	return Result::eSuccess;
+}
+
+
+std::vector<UploadManager::ImageSubresource> UploadManager::CollectImageSubresources() const
+{
+	//	Expand copies to single layers, the stable sort keeps repeated layers in upload order.
+	std::vector<ImageSubresource> Layers;
+
+	for (auto & Copy : m_ImageCopies)
+	{
+		const VkImageSubresourceLayers & subresource = Copy.region.imageSubresource;
+
+		for (uint32_t i = 0; i < subresource.layerCount; i++)
+		{
+			Layers.push_back({ Copy.hDstImage, subresource.aspectMask, subresource.mipLevel, subresource.baseArrayLayer + i, 1, Copy.eCurrentLayout, Copy.eFinalLayout });
+		}
+	}
+
+	auto Key = [](const ImageSubresource & layer) { return std::make_tuple(layer.hImage, layer.aspectMask, layer.mipLevel, layer.baseArrayLayer); };
+
+	std::stable_sort(Layers.begin(), Layers.end(), [&](const ImageSubresource & a, const ImageSubresource & b) { return Key(a) < Key(b); });
+
+	//	A layer uploaded twice keeps the layout before its first copy and ends in the final layout of its last copy.
+	std::vector<ImageSubresource> UniqueLayers;
+
+	for (auto & Layer : Layers)
+	{
+		if (!UniqueLayers.empty() && (Key(UniqueLayers.back()) == Key(Layer)))
+		{
+			UniqueLayers.back().eFinalLayout = Layer.eFinalLayout;
+		}
+		else
+		{
+			UniqueLayers.push_back(Layer);
+		}
+	}
+
+	//	Merge adjacent layers of the same mip sharing both layouts into one range.
+	std::vector<ImageSubresource> Subresources;
+
+	for (auto & Layer : UniqueLayers)
+	{
+		if (!Subresources.empty())
+		{
+			ImageSubresource & Range = Subresources.back();
+
+			if ((Range.hImage == Layer.hImage) && (Range.aspectMask == Layer.aspectMask) && (Range.mipLevel == Layer.mipLevel) &&
+				(Range.baseArrayLayer + Range.layerCount == Layer.baseArrayLayer) &&
+				(Range.eCurrentLayout == Layer.eCurrentLayout) && (Range.eFinalLayout == Layer.eFinalLayout))
+			{
+				Range.layerCount++;
+
+				continue;
+			}
+		}
+
+		Subresources.push_back(Layer);
+	}
+
+	return Subresources;
+}
+
+
+void UploadManager::RecordCopies(CommandBuffer * pCommandBuffer, AcquireBarriers * pAcquireBarriers)
+{
+	const uint32_t srcFamilyIndex = m_pQueue->GetFamilyIndex();
+
+	const bool isOwnershipTransfer = (m_DstFamilyIndex != LAVA_INVALID_INDEX) && (m_DstFamilyIndex != srcFamilyIndex);
+
+	const std::vector<ImageSubresource> Subresources = this->CollectImageSubresources();
+
+	std::vector<VkImageMemoryBarrier> ImageBarriers;
+
+	bool hasPreviousContents = false;
+
+	for (auto & Subresource : Subresources)
+	{
+		const bool isDiscarded = (Subresource.eCurrentLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+
+		VkImageMemoryBarrier					Barrier = {};
+		Barrier.sType							= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		Barrier.pNext							= nullptr;
+		Barrier.srcAccessMask					= isDiscarded ? 0 : VK_ACCESS_MEMORY_WRITE_BIT;
+		Barrier.dstAccessMask					= VK_ACCESS_TRANSFER_WRITE_BIT;
+		Barrier.oldLayout						= Subresource.eCurrentLayout;
+		Barrier.newLayout						= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		Barrier.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED;
+		Barrier.image							= Subresource.hImage;
+		Barrier.subresourceRange.aspectMask		= Subresource.aspectMask;
+		Barrier.subresourceRange.baseMipLevel	= Subresource.mipLevel;
+		Barrier.subresourceRange.levelCount		= 1;
+		Barrier.subresourceRange.baseArrayLayer	= Subresource.baseArrayLayer;
+		Barrier.subresourceRange.layerCount		= Subresource.layerCount;
+
+		hasPreviousContents |= !isDiscarded;
+
+		ImageBarriers.push_back(Barrier);
+	}
+
+	if (!ImageBarriers.empty())
+	{
+		//	Preserved contents may still be written by earlier work on this queue.
+		const vk::PipelineStageFlags eSrcStages = hasPreviousContents ? vk::PipelineStageFlagBits::eAllCommands : vk::PipelineStageFlagBits::eTopOfPipe;
+
+		pCommandBuffer->CmdPipelineBarrier(eSrcStages, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), {}, ImageBarriers);
+	}
+
+	//	Group copies into the same buffer into one command.
+	std::sort(m_BufferCopies.begin(), m_BufferCopies.end(), [](const BufferCopy & a, const BufferCopy & b) { return a.hDstBuffer < b.hDstBuffer; });
+
+	for (size_t i = 0; i < m_BufferCopies.size();)
+	{
+		size_t j = i;
+
+		std::vector<VkBufferCopy> Regions;
+
+		for (; (j < m_BufferCopies.size()) && (m_BufferCopies[j].hDstBuffer == m_BufferCopies[i].hDstBuffer); j++)
+		{
+			Regions.push_back(m_BufferCopies[j].region);
+		}
+
+		pCommandBuffer->CmdCopyBuffer(m_StagingRing, m_BufferCopies[i].hDstBuffer, Regions);
+
+		i = j;
+	}
+
+	for (auto & Copy : m_ImageCopies)
+	{
+		pCommandBuffer->CmdCopyBufferToImage(m_StagingRing, Copy.hDstImage, vk::ImageLayout::eTransferDstOptimal, Copy.region);
+	}
+
+	//	Release barriers: transition images to the final layout and hand ownership to the consuming family.
+	std::vector<VkBufferMemoryBarrier> BufferBarriers;
+
+	if (isOwnershipTransfer)
+	{
+		for (auto & Copy : m_BufferCopies)
+		{
+			VkBufferMemoryBarrier				Barrier = {};
+			Barrier.sType						= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			Barrier.pNext						= nullptr;
+			Barrier.srcAccessMask				= VK_ACCESS_TRANSFER_WRITE_BIT;
+			Barrier.dstAccessMask				= 0;
+			Barrier.srcQueueFamilyIndex			= srcFamilyIndex;
+			Barrier.dstQueueFamilyIndex			= m_DstFamilyIndex;
+			Barrier.buffer						= Copy.hDstBuffer;
+			Barrier.offset						= Copy.region.dstOffset;
+			Barrier.size						= Copy.region.size;
+
+			BufferBarriers.push_back(Barrier);
+		}
+	}
+
+	for (size_t i = 0; i < Subresources.size(); i++)
+	{
+		ImageBarriers[i].srcAccessMask			= VK_ACCESS_TRANSFER_WRITE_BIT;
+		ImageBarriers[i].dstAccessMask			= 0;
+		ImageBarriers[i].oldLayout				= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		ImageBarriers[i].newLayout				= Subresources[i].eFinalLayout;
+		ImageBarriers[i].srcQueueFamilyIndex	= isOwnershipTransfer ? srcFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+		ImageBarriers[i].dstQueueFamilyIndex	= isOwnershipTransfer ? m_DstFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+	}
+
+	if (!BufferBarriers.empty() || !ImageBarriers.empty())
+	{
+		pCommandBuffer->CmdPipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, vk::DependencyFlags(), BufferBarriers, ImageBarriers);
+	}
+
+	//	Matching acquire barriers, recorded by the consuming queue.
+	if (isOwnershipTransfer)
+	{
+		for (auto & Barrier : BufferBarriers)
+		{
+			Barrier.srcAccessMask = 0;
+
+			Barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+
+		for (auto & Barrier : ImageBarriers)
+		{
+			Barrier.srcAccessMask = 0;
+
+			Barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+
+		pAcquireBarriers->BufferBarriers = std::move(BufferBarriers);
+
+		pAcquireBarriers->ImageBarriers = std::move(ImageBarriers);
+	}
+
+	m_BufferCopies.clear();
+
+	m_ImageCopies.clear();
+}
+
+
+Result UploadManager::Submit(Token * pToken)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	return this->SubmitLocked(pToken);
+}
+
+
+std::unique_ptr<UploadManager::Batch> UploadManager::AcquireBatch()
+{
+	std::unique_ptr<Batch> spBatch;
+
+	if (!m_FreeBatches.empty())
+	{
+		spBatch = std::move(m_FreeBatches.back());
+
+		m_FreeBatches.pop_back();
+
+		spBatch->fence.Reset();
+
+		spBatch->pCommandBuffer->Reset();
+	}
+	else
+	{
+		spBatch = std::make_unique<Batch>();
+
+		spBatch->pCommandBuffer = m_pCommandPool->AllocatePrimaryCommandBuffer();
+
+		if (spBatch->pCommandBuffer == nullptr)		return nullptr;
+
+		if (spBatch->fence.Create(m_hDevice) != Result::eSuccess)
+		{
+			m_pCommandPool->FreeCommandBuffer(spBatch->pCommandBuffer);
+
+			return nullptr;
+		}
+	}
+
+	//	A released token whose semaphore was waited on leaves it unsignaled, otherwise it cannot be signaled again.
+	if ((spBatch->spSemaphore == nullptr) || (spBatch->spSemaphore.use_count() != 1) || !spBatch->spSemaphore->isWaited)
+	{
+		spBatch->spSemaphore = std::make_shared<CompletionSemaphore>(m_hDevice);
+	}
+
+	spBatch->spSemaphore->isWaited = false;
+
+	return spBatch;
+}
+
+
+Result UploadManager::SubmitLocked(Token * pToken)
+{
+	if (m_BufferCopies.empty() && m_ImageCopies.empty())
+	{
+		//	Nothing queued, the token of the last batch is still meaningful.
+		this->HandOutToken(pToken);
+
+		return Result::eSuccess;
+	}
+
+	this->Retire();
+
+	std::unique_ptr<Batch> spBatch = this->AcquireBatch();
+
+	if (spBatch == nullptr)
+	{
+		m_BufferCopies.clear();
+
+		m_ImageCopies.clear();
+
+		return Result::eErrorOutOfDeviceMemory;
+	}
+
+	AcquireBarriers BatchAcquireBarriers;
+
+	Result eResult = spBatch->pCommandBuffer->BeginRecord(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+	if (eResult == Result::eSuccess)
+	{
+		this->RecordCopies(spBatch->pCommandBuffer, &BatchAcquireBarriers);
+
+		eResult = spBatch->pCommandBuffer->EndRecord();
+	}
+
+	//	Flushes non-coherent staging memory, must happen before the submission.
+	if (eResult == Result::eSuccess)
+	{
+		eResult = m_StagingRing.Flush();
+	}
+
+	if (eResult == Result::eSuccess)
+	{
+		eResult = spBatch->pCommandBuffer->Submit(VK_NULL_HANDLE, vk::PipelineStageFlags(), spBatch->spSemaphore->semaphore.Handle(), spBatch->fence);
+	}
+
+	if (eResult != Result::eSuccess)
+	{
+		//	Copies are dropped, their staging bytes stay in the open frame and retire with the next batch.
+		m_BufferCopies.clear();
+
+		m_ImageCopies.clear();
+
+		//	Never submitted, so the semaphore is still unsignaled.
+		spBatch->spSemaphore->isWaited = true;
+
+		m_FreeBatches.push_back(std::move(spBatch));
+
+		return eResult;
+	}
+
+	//	The fence is only registered once it is guaranteed to signal.
+	m_StagingRing.CloseFrame(spBatch->fence);
+
+	spBatch->value = ++m_SubmittedValue;
+
+	//	Batches flushed by a full ring have no token, their acquire barriers go to the next one.
+	auto & PendingBuffers = m_PendingAcquireBarriers.BufferBarriers;
+
+	auto & PendingImages = m_PendingAcquireBarriers.ImageBarriers;
+
+	PendingBuffers.insert(PendingBuffers.end(), BatchAcquireBarriers.BufferBarriers.begin(), BatchAcquireBarriers.BufferBarriers.end());
+
+	PendingImages.insert(PendingImages.end(), BatchAcquireBarriers.ImageBarriers.begin(), BatchAcquireBarriers.ImageBarriers.end());
+
+	m_spUntokenedSemaphore = spBatch->spSemaphore;
+
+	m_PendingBatches.push_back(std::move(spBatch));
+
+	this->HandOutToken(pToken);
+
+	return Result::eSuccess;
+}
+
+
+void UploadManager::HandOutToken(Token * pToken)
+{
+	if (pToken == nullptr)		return;
+
+	*pToken = Token();
+
+	pToken->value = m_SubmittedValue;
+
+	//	Signaled after all earlier work of the queue, so it also covers batches flushed without a token.
+	pToken->spSemaphore = std::move(m_spUntokenedSemaphore);
+
+	if (!m_PendingAcquireBarriers.BufferBarriers.empty() || !m_PendingAcquireBarriers.ImageBarriers.empty())
+	{
+		pToken->spAcquireBarriers = std::make_shared<const AcquireBarriers>(std::move(m_PendingAcquireBarriers));
+	}
+
+	m_spUntokenedSemaphore = nullptr;
+
+	m_PendingAcquireBarriers = AcquireBarriers();
+}
+
+
+void UploadManager::CmdAcquire(CommandBuffer * pCommandBuffer, const Token & token)
+{
+	if (token.spAcquireBarriers == nullptr)		return;
+
+	auto & BufferBarriers = token.spAcquireBarriers->BufferBarriers;
+
+	auto & ImageBarriers = token.spAcquireBarriers->ImageBarriers;
+
+	if (!BufferBarriers.empty() || !ImageBarriers.empty())
+	{
+		pCommandBuffer->CmdPipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, vk::DependencyFlags(), BufferBarriers, ImageBarriers);
+	}
+}
+
+
+void UploadManager::Retire()
+{
+	size_t completedCount = 0;
+
+	for (; completedCount < m_PendingBatches.size(); completedCount++)
+	{
+		if (m_PendingBatches[completedCount]->fence.Status() != Result::eSuccess)		break;
+	}
+
+	//	Fences stay signaled until they are reused, so the ring sees at least the batches seen here.
+	m_StagingRing.Retire();
+
+	for (size_t i = 0; i < completedCount; i++)
+	{
+		m_CompletedValue = m_PendingBatches.front()->value;
+
+		m_FreeBatches.push_back(std::move(m_PendingBatches.front()));
+
+		m_PendingBatches.pop_front();
+	}
+}
+
+
+bool UploadManager::IsComplete(const Token & token)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	if (token.value > m_CompletedValue)
+	{
+		this->Retire();
+	}
+
+	return token.value <= m_CompletedValue;
+}
+
+
+Result UploadManager::Wait(const Token & token, uint64_t timeout)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	for (auto & spBatch : m_PendingBatches)
+	{
+		if (spBatch->value == token.value)
+		{
+			Result eResult = spBatch->fence.Wait(timeout);
+
+			this->Retire();
+
+			return eResult;
+		}
+	}
+
+	return Result::eSuccess;
+}
+
+
+void UploadManager::Destroy()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	for (auto & spBatch : m_PendingBatches)
+	{
+		spBatch->fence.Wait();
+	}
+
+	m_PendingBatches.clear();
+
+	m_FreeBatches.clear();
+
+	m_BufferCopies.clear();
+
+	m_ImageCopies.clear();
+
+	m_PendingAcquireBarriers = AcquireBarriers();
+
+	m_spUntokenedSemaphore = nullptr;
+
+	m_StagingRing.Destroy();
+
+	if (m_pCommandPool != nullptr)
+	{
+		m_pQueue->DestroyCommandPool(m_pCommandPool);
+
+		m_pCommandPool = nullptr;
+	}
+
+	m_pQueue = nullptr;
+
+	m_hDevice = VK_NULL_HANDLE;
+}
+
+
+UploadManager::~UploadManager()
+{
+	this->Destroy();
+}
\ No newline at end of file
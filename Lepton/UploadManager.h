@@ -0,0 +1,216 @@
+/*************************************************************************
+***********************    Lepton_UploadManager    ***********************
+*************************************************************************/
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include "Sync.h"
+#include "Buffers.h"
+
+namespace Lepton
+{
+	/*********************************************************************
+	************************    UploadManager    *************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Packs host-to-device uploads into a staging ring and copies them on the transfer queue.
+	 */
+	class UploadManager
+	{
+		LAVA_NONCOPYABLE(UploadManager)
+
+	public:
+
+		/**
+		 *	@brief	Ownership acquire barriers to be recorded on the consuming queue.
+		 */
+		struct AcquireBarriers
+		{
+			std::vector<VkBufferMemoryBarrier>		BufferBarriers;
+			std::vector<VkImageMemoryBarrier>		ImageBarriers;
+		};
+
+		/**
+		 *	@brief	Semaphore signaled by a batch, recycled with the batch once it was handed out for a wait and released.
+		 */
+		struct CompletionSemaphore
+		{
+			Semaphore						semaphore;
+			std::atomic_bool				isWaited;
+
+			explicit CompletionSemaphore(VkDevice hDevice) : semaphore(hDevice), isWaited(false) {}
+		};
+
+		/**
+		 *	@brief	Completion token of a submitted batch.
+		 *	@note	Wait on Handle() in exactly one submission, keep the token alive until that submission completed.
+		 */
+		struct Token
+		{
+			uint64_t									value			= 0;
+			std::shared_ptr<CompletionSemaphore>		spSemaphore;
+			std::shared_ptr<const AcquireBarriers>		spAcquireBarriers;
+
+			//!	@brief	Semaphore to wait on before consuming the uploaded data (VK_NULL_HANDLE if nothing was submitted).
+			VkSemaphore Handle() const
+			{
+				if (spSemaphore == nullptr)		return VK_NULL_HANDLE;
+
+				spSemaphore->isWaited = true;
+
+				return spSemaphore->semaphore.Handle();
+			}
+		};
+
+	public:
+
+		//!	@brief	Create upload manager object.
+		UploadManager();
+
+		//!	@brief	Destroy upload manager object (waits for pending batches).
+		~UploadManager();
+
+	public:
+
+		/**
+		 *	@brief		Create a new upload manager.
+		 *	@param[in]	pTransferQueue - Queue recording the copies, usually from GetTransferQueueFamilyIndex().
+		 *	@param[in]	dstFamilyIndex - Queue family consuming the data, ownership is transferred to it when it differs.
+		 */
+		Result Create(const LogicalDevice * pLogicalDevice, CommandQueue * pTransferQueue, uint32_t dstFamilyIndex, VkDeviceSize stagingSize = LAVA_DEFAULT_BLOCK_SIZE);
+
+		//!	@brief	Queue a buffer upload, large uploads are split into several copies.
+		Result Upload(VkBuffer hDstBuffer, VkDeviceSize dstOffset, const void * pHostData, VkDeviceSize size);
+
+		/**
+		 *	@brief		Queue an image upload (tightly packed texel blocks, layer by layer), the image is left in eFinalLayout.
+		 *	@param[in]	eFormat - Format of the image, large uploads are split by layers, slices and block rows.
+		 *	@param[in]	eCurrentLayout - Layout of the subresource before the upload, eUndefined discards its contents (kept only if owned by the transfer family).
+		 */
+		Result Upload(VkImage hDstImage, vk::Format eFormat, const VkImageSubresourceLayers & subresource, VkOffset3D offset, VkExtent3D extent,
+					  const void * pHostData, VkDeviceSize size, vk::ImageLayout eFinalLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+					  vk::ImageLayout eCurrentLayout = vk::ImageLayout::eUndefined);
+
+		//!	@brief	Record and submit all queued uploads, write the token of this batch (queued uploads are dropped on failure).
+		Result Submit(Token * pToken);
+
+		//!	@brief	Record ownership acquire barriers of the batch on the consuming queue (no-op for the same family).
+		static void CmdAcquire(CommandBuffer * pCommandBuffer, const Token & token);
+
+		//!	@brief	If the batch of the token has completed on the device.
+		bool IsComplete(const Token & token);
+
+		//!	@brief	Block until the batch of the token has completed.
+		Result Wait(const Token & token, uint64_t timeout = LAVA_DEFAULT_TIMEOUT);
+
+		//!	@brief	Destroy the upload manager.
+		void Destroy();
+
+	private:
+
+		/**
+		 *	@brief	Copies recorded into one command buffer.
+		 */
+		struct Batch
+		{
+			uint64_t						value				= 0;
+			Fence									fence;
+			CommandBuffer *							pCommandBuffer		= nullptr;
+			std::shared_ptr<CompletionSemaphore>	spSemaphore;
+		};
+
+		/**
+		 *	@brief	Queued buffer copy.
+		 */
+		struct BufferCopy
+		{
+			VkBuffer				hDstBuffer;
+			VkBufferCopy			region;
+		};
+
+		/**
+		 *	@brief	Queued image copy.
+		 */
+		struct ImageCopy
+		{
+			VkImage					hDstImage;
+			VkBufferImageCopy		region;
+			VkImageLayout			eCurrentLayout;
+			VkImageLayout			eFinalLayout;
+		};
+
+		/**
+		 *	@brief	Layer range of one image mip transitioned around the copies.
+		 */
+		struct ImageSubresource
+		{
+			VkImage					hImage;
+			VkImageAspectFlags		aspectMask;
+			uint32_t				mipLevel;
+			uint32_t				baseArrayLayer;
+			uint32_t				layerCount;
+			VkImageLayout			eCurrentLayout;
+			VkImageLayout			eFinalLayout;
+		};
+
+	private:
+
+		//!	@brief	Copy host data into the ring and queue its copy to the image region (lock must be held).
+		Result QueueImageCopy(VkImage hDstImage, const VkImageSubresourceLayers & subresource, VkOffset3D offset, VkExtent3D extent,
+							  const void * pHostData, VkDeviceSize size, VkDeviceSize alignment, VkImageLayout eCurrentLayout, VkImageLayout eFinalLayout);
+
+		//!	@brief	Allocate staging memory, submitting and waiting for old batches if the ring is full.
+		RingBuffer::Allocation AllocateStaging(VkDeviceSize size, VkDeviceSize alignment);
+
+		//!	@brief	Record queued copies and release barriers (lock must be held).
+		void RecordCopies(CommandBuffer * pCommandBuffer, AcquireBarriers * pAcquireBarriers);
+
+		//!	@brief	Merge queued image copies into one entry per subresource, in first-seen current and last-seen final layout.
+		std::vector<ImageSubresource> CollectImageSubresources() const;
+
+		//!	@brief	Take a recycled batch or create a new one.
+		std::unique_ptr<Batch> AcquireBatch();
+
+		//!	@brief	Submit queued copies (lock must be held).
+		Result SubmitLocked(Token * pToken);
+
+		//!	@brief	Write the token of the last batch, carrying the acquire barriers of every batch since the previous token.
+		void HandOutToken(Token * pToken);
+
+		//!	@brief	Recycle completed batches (lock must be held).
+		void Retire();
+
+	private:
+
+		std::mutex									m_Mutex;
+
+		VkDevice									m_hDevice;
+
+		CommandQueue *								m_pQueue;
+
+		CommandPool *								m_pCommandPool;
+
+		RingBuffer									m_StagingRing;
+
+		uint32_t									m_DstFamilyIndex;
+
+		uint64_t									m_SubmittedValue;
+
+		uint64_t									m_CompletedValue;
+
+		std::vector<BufferCopy>						m_BufferCopies;
+
+		std::vector<ImageCopy>						m_ImageCopies;
+
+		AcquireBarriers								m_PendingAcquireBarriers;
+
+		std::shared_ptr<CompletionSemaphore>		m_spUntokenedSemaphore;
+
+		std::deque<std::unique_ptr<Batch>>			m_PendingBatches;
+
+		std::vector<std::unique_ptr<Batch>>			m_FreeBatches;
+	};
+}
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #define LAVA_INVALID_INDEX				UINT32_MAX
 #define LAVA_DEFAULT_TIMEOUT			100000000000L	//!	100s.
+#define LAVA_DEFAULT_BLOCK_SIZE			67108864ULL		//!	64MB.
 #define LAVA_RESULT_CAST(eResult)		static_cast<Result>(eResult)
 
 /*************************************************************************
@@ -60,6 +61,9 @@ namespace Lepton
 	class CommandPool;
 	class CommandQueue;
 	class CommandBuffer;
+	class SubmitBatch;
+	class ParallelRenderPass;
+	class CommandContextManager;
 
 	class Image1D;
 	class Image2D;
@@ -73,20 +77,76 @@ namespace Lepton
 	class Fence;
 	class Sampler;
 	class Semaphore;
+	class TimelineSemaphore;
 	class Swapchain;
 	class RenderPass;
+	class RingBuffer;
+	class UniformStreamer;
 	class Framebuffer;
 	class ShaderModule;
+	class SpecializationConstants;
+	class ShaderArchive;
+	class ShaderReflection;
 	class Win32Surface;
 	class DeviceMemory;
 	class DescriptorSet;
 	class DescriptorPool;
+	class DescriptorAllocator;
+	class DescriptorWriter;
+	class DescriptorUpdateTemplate;
+	class BindlessTable;
+	class DescriptorBuffer;
+	class UploadManager;
+	class DeletionQueue;
+	class PipelineCache;
+	class PipelineCompiler;
+	class MemoryAllocator;
 	class PipelineLayout;
+	class LayoutCache;
 	class ComputePipeline;
 	class GraphicsPipeline;
+	class GraphicsPipelineCache;
 	class HostVisibleBuffer;
 	class DeviceLocalBuffer;
 	class RayTracingPipelineNV;
+
+	/*********************************************************************
+	*************************    MemoryUsage    **************************
+	*********************************************************************/
+
+	/**
+	 *	@brief	Intended usage of memory, used to rank memory types.
+	 */
+	enum class MemoryUsage
+	{
+		eGpuOnly,			//!	Device access only, prefers device-local memory that is not host-visible.
+		eCpuOnly,			//!	Staging written once by host, host-visible and host-coherent memory outside the device-local heap.
+		eCpuToGpu,			//!	Written by host every frame, prefers device-local host-visible (ReBAR) memory.
+		eGpuToCpu,			//!	Read back by host, prefers host-cached memory.
+		eGpuLazy,			//!	Transient attachments, prefers lazily-allocated memory.
+	};
+
+	/*********************************************************************
+	*****************************    Hash    *****************************
+	*********************************************************************/
+
+	//!	@brief	Initial value of a 64-bit FNV-1a hash.
+	constexpr uint64_t HashSeed = 0xCBF29CE484222325ull;
+
+	//!	@brief	Continue a 64-bit FNV-1a hash over raw bytes.
+	inline void HashBytes(uint64_t & hash, const void * pData, size_t sizeBytes)
+	{
+		for (size_t i = 0; i < sizeBytes; i++)
+		{
+			hash = (hash ^ static_cast<const uint8_t*>(pData)[i]) * 0x100000001B3ull;
+		}
+	}
+
+	//!	@brief	Continue a 64-bit FNV-1a hash over the bytes of a value (the type must have no padding).
+	template<typename Type> inline void HashValue(uint64_t & hash, const Type & value)
+	{
+		HashBytes(hash, &value, sizeof(Type));
+	}
 }
 
 typedef Lepton::Instance					LnInstance;
@@ -96,6 +156,9 @@ typedef Lepton::PhysicalDevice				LnPhysicalDevice;
 typedef Lepton::CommandPool					LnCommandPool;
 typedef Lepton::CommandQueue				LnCommandQueue;
 typedef Lepton::CommandBuffer				LnCommandBuffer;
+typedef Lepton::SubmitBatch					LnSubmitBatch;
+typedef Lepton::ParallelRenderPass			LnParallelRenderPass;
+typedef Lepton::CommandContextManager		LnCommandContextManager;
 
 typedef Lepton::Image1D						LnImage1D;
 typedef Lepton::Image2D						LnImage2D;
@@ -109,18 +172,36 @@ typedef Lepton::Event						LnEvent;
 typedef Lepton::Fence						LnFence;
 typedef Lepton::Sampler						LnSampler;
 typedef Lepton::Semaphore					LnSemaphore;
+typedef Lepton::TimelineSemaphore			LnTimelineSemaphore;
 typedef Lepton::Swapchain					LnSwapchain;
 typedef Lepton::RenderPass					LnRenderPass;
+typedef Lepton::RingBuffer					LnRingBuffer;
+typedef Lepton::UniformStreamer				LnUniformStreamer;
 typedef Lepton::Framebuffer					LnFramebuffer;
 typedef Lepton::ShaderModule				LnShaderModule;
+typedef Lepton::SpecializationConstants		LnSpecializationConstants;
+typedef Lepton::ShaderArchive				LnShaderArchive;
+typedef Lepton::ShaderReflection			LnShaderReflection;
 typedef Lepton::Win32Surface				LnWin32Surface;
 typedef Lepton::DeviceMemory				LnDeviceMemory;
+typedef Lepton::UploadManager				LnUploadManager;
+typedef Lepton::DeletionQueue				LnDeletionQueue;
+typedef Lepton::PipelineCache				LnPipelineCache;
+typedef Lepton::PipelineCompiler			LnPipelineCompiler;
+typedef Lepton::MemoryAllocator				LnMemoryAllocator;
 typedef Lepton::PipelineLayout				LnPipelineLayout;
+typedef Lepton::LayoutCache					LnLayoutCache;
 typedef Lepton::ComputePipeline				LnComputePipeline;
 typedef Lepton::GraphicsPipeline			LnGraphicsPipeline;
+typedef Lepton::GraphicsPipelineCache		LnGraphicsPipelineCache;
 typedef Lepton::HostVisibleBuffer			LnHostVisibleBuffer;
 typedef Lepton::DeviceLocalBuffer			LnDeviceLocalBuffer;
 typedef Lepton::RayTracingPipelineNV		LnRayTracingPipeline;
 
 typedef Lepton::DescriptorSet				LnDescriptorSet;
-typedef Lepton::DescriptorPool				LnDescriptorPool;
\ No newline at end of file
+typedef Lepton::DescriptorPool				LnDescriptorPool;
+typedef Lepton::DescriptorAllocator			LnDescriptorAllocator;
+typedef Lepton::DescriptorWriter			LnDescriptorWriter;
+typedef Lepton::DescriptorUpdateTemplate	LnDescriptorUpdateTemplate;
+typedef Lepton::BindlessTable				LnBindlessTable;
+typedef Lepton::DescriptorBuffer			LnDescriptorBuffer;
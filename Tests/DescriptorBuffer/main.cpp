@@ -0,0 +1,428 @@
+/*************************************************************************
+**********************    DescriptorBufferTest    ************************
+*************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include "Images.h"
+#include "Sampler.h"
+#include "Sync.h"
+#include "Commands.h"
+#include "Instance.h"
+#include "LogicalDevice.h"
+#include "PhysicalDevice.h"
+#include "ComputePipeline.h"
+#include "DescriptorBuffer.h"
+
+using namespace Lepton;
+
+//	Exit codes, 77 marks the check as skipped (no device with VK_EXT_descriptor_buffer, e.g. lavapipe is not installed).
+static constexpr int	ExitSuccess		= 0;
+static constexpr int	ExitFailure		= 1;
+static constexpr int	ExitSkipped		= 77;
+
+#ifdef VK_EXT_descriptor_buffer
+
+static constexpr uint32_t		UniformValue		= 40;
+static constexpr uint32_t		TexelValue			= 2;
+
+/*************************************************************************
+************************    AddressableBuffer    *************************
+*************************************************************************/
+
+/**
+ *	@brief	Host-visible buffer with a device address, descriptor buffers reference buffers only by address.
+ */
+struct AddressableBuffer
+{
+	VkDevice				hDevice			= VK_NULL_HANDLE;
+	VkBuffer				hBuffer			= VK_NULL_HANDLE;
+	VkDeviceMemory			hMemory			= VK_NULL_HANDLE;
+	VkDeviceAddress			address			= 0;
+	uint32_t *				pMappedData		= nullptr;
+
+	//!	@brief	Create the buffer, device address usage is added to eUsages.
+	Result Create(const LogicalDevice * pLogicalDevice, VkDeviceSize size, VkBufferUsageFlags eUsages)
+	{
+		hDevice = pLogicalDevice->Handle();
+
+		VkBufferCreateInfo						CreateInfo = {};
+		CreateInfo.sType						= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		CreateInfo.pNext						= nullptr;
+		CreateInfo.flags						= 0;
+		CreateInfo.size							= size;
+		CreateInfo.usage						= eUsages | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+		CreateInfo.sharingMode					= VK_SHARING_MODE_EXCLUSIVE;
+		CreateInfo.queueFamilyIndexCount		= 0;
+		CreateInfo.pQueueFamilyIndices			= nullptr;
+
+		Result eResult = LAVA_RESULT_CAST(vkCreateBuffer(hDevice, &CreateInfo, nullptr, &hBuffer));
+
+		if (eResult != Result::eSuccess)		return eResult;
+
+		VkMemoryRequirements Requirements = {};
+
+		vkGetBufferMemoryRequirements(hDevice, hBuffer, &Requirements);
+
+		VkMemoryAllocateFlagsInfoKHR			AllocateFlagsInfo = {};
+		AllocateFlagsInfo.sType					= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+		AllocateFlagsInfo.pNext					= nullptr;
+		AllocateFlagsInfo.flags					= VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+		AllocateFlagsInfo.deviceMask			= 0;
+
+		VkMemoryAllocateInfo					AllocateInfo = {};
+		AllocateInfo.sType						= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		AllocateInfo.pNext						= &AllocateFlagsInfo;
+		AllocateInfo.allocationSize				= Requirements.size;
+		AllocateInfo.memoryTypeIndex			= pLogicalDevice->GetPhysicalDevice()->GetMemoryTypeIndex(Requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+		if (AllocateInfo.memoryTypeIndex == LAVA_INVALID_INDEX)		return Result::eErrorInvalidMemoryTypeBits;
+
+		eResult = LAVA_RESULT_CAST(vkAllocateMemory(hDevice, &AllocateInfo, nullptr, &hMemory));
+
+		if (eResult == Result::eSuccess)		eResult = LAVA_RESULT_CAST(vkBindBufferMemory(hDevice, hBuffer, hMemory, 0));
+
+		if (eResult == Result::eSuccess)		eResult = LAVA_RESULT_CAST(vkMapMemory(hDevice, hMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&pMappedData)));
+
+		if (eResult != Result::eSuccess)		return eResult;
+
+		auto pfnGetBufferDeviceAddress = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(hDevice, "vkGetBufferDeviceAddressKHR");
+
+		if (!pfnGetBufferDeviceAddress)			return Result::eErrorFailedToGetProcessAddress;
+
+		VkBufferDeviceAddressInfoKHR			AddressInfo = {};
+		AddressInfo.sType						= VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+		AddressInfo.pNext						= nullptr;
+		AddressInfo.buffer						= hBuffer;
+
+		address = pfnGetBufferDeviceAddress(hDevice, &AddressInfo);
+
+		return Result::eSuccess;
+	}
+
+	//!	@brief	Destroy immediately, the device must be idle.
+	~AddressableBuffer()
+	{
+		if (hBuffer != VK_NULL_HANDLE)		vkDestroyBuffer(hDevice, hBuffer, nullptr);
+		if (hMemory != VK_NULL_HANDLE)		vkFreeMemory(hDevice, hMemory, nullptr);
+	}
+};
+
+/*************************************************************************
+******************************    Check    *******************************
+*************************************************************************/
+
+/**
+ *	@brief	Report a failed step.
+ */
+static int Fail(const char * pStep, Result eResult)
+{
+	std::printf("DescriptorBufferTest: %s failed (%d).\n", pStep, static_cast<int>(eResult));
+
+	return ExitFailure;
+}
+
+
+/**
+ *	@brief	Write a uniform buffer, a storage buffer, a sampled image and a sampler into a descriptor buffer,
+ *			bind both sets by offset, dispatch once and check the value the shader wrote back.
+ */
+static int RunCheck(LogicalDevice * pLogicalDevice, CommandQueue * pCommandQueue, const char * pShaderPath)
+{
+	const VkDevice hDevice = pLogicalDevice->Handle();
+
+	AddressableBuffer uniformBuffer, resultBuffer;
+
+	Result eResult = uniformBuffer.Create(pLogicalDevice, 256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+
+	if (eResult != Result::eSuccess)		return Fail("Uniform buffer creation", eResult);
+
+	eResult = resultBuffer.Create(pLogicalDevice, 256, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+	if (eResult != Result::eSuccess)		return Fail("Result buffer creation", eResult);
+
+	*uniformBuffer.pMappedData = UniformValue;
+
+	*resultBuffer.pMappedData = 0;
+
+	Image2D image;
+
+	eResult = image.Create(pLogicalDevice, vk::Format::eR32Uint, { 1, 1 }, 1, vk::SampleCountFlagBits::e1, vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst, vk::ImageAspectFlagBits::eColor);
+
+	if (eResult != Result::eSuccess)		return Fail("Image creation", eResult);
+
+	Sampler sampler;
+
+	eResult = sampler.Create(hDevice);
+
+	if (eResult != Result::eSuccess)		return Fail("Sampler creation", eResult);
+
+	//	Set 0 holds the buffers, set 1 the image and its sampler.
+	std::vector<vk::DescriptorSetLayoutBinding> BufferBindings =
+	{
+		vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+	};
+
+	std::vector<vk::DescriptorSetLayoutBinding> ImageBindings =
+	{
+		vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eSampledImage, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eSampler, 1, vk::ShaderStageFlagBits::eCompute),
+	};
+
+	DescriptorSetLayout bufferSetLayout, imageSetLayout;
+
+	eResult = bufferSetLayout.Create(hDevice, BufferBindings, vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT);
+
+	if (eResult != Result::eSuccess)		return Fail("Buffer set layout creation", eResult);
+
+	eResult = imageSetLayout.Create(hDevice, ImageBindings, vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT);
+
+	if (eResult != Result::eSuccess)		return Fail("Image set layout creation", eResult);
+
+	std::vector<DescriptorSetLayout> SetLayouts = { bufferSetLayout, imageSetLayout };
+
+	PipelineLayout pipelineLayout;
+
+	eResult = pipelineLayout.Create(hDevice, SetLayouts);
+
+	if (eResult != Result::eSuccess)		return Fail("Pipeline layout creation", eResult);
+
+	ComputePipelineParam				Param;
+	Param.flags							= vk::PipelineCreateFlagBits::eDescriptorBufferEXT;
+	Param.pipelineLayout				= pipelineLayout;
+
+	eResult = Param.shaderStage.Create(hDevice, pShaderPath, vk::ShaderStageFlagBits::eCompute);
+
+	if (eResult != Result::eSuccess)		return Fail("Shader module creation", eResult);
+
+	ComputePipeline computePipeline;
+
+	eResult = computePipeline.Create(pLogicalDevice, Param);
+
+	if (eResult != Result::eSuccess)		return Fail("Compute pipeline creation", eResult);
+
+	DescriptorBuffer descriptorBuffer;
+
+	eResult = descriptorBuffer.Create(pLogicalDevice, 64 * 1024);
+
+	if (eResult != Result::eSuccess)		return Fail("Descriptor buffer creation", eResult);
+
+	//	An unused set first, so that neither bound set sits at offset 0.
+	const VkDeviceSize paddingOffset = descriptorBuffer.AllocateSet(imageSetLayout);
+
+	std::vector<VkDeviceSize> SetOffsets = { descriptorBuffer.AllocateSet(bufferSetLayout), descriptorBuffer.AllocateSet(imageSetLayout) };
+
+	if ((paddingOffset == VK_WHOLE_SIZE) || (SetOffsets[0] == VK_WHOLE_SIZE) || (SetOffsets[1] == VK_WHOLE_SIZE))
+	{
+		return Fail("Descriptor set allocation", Result::eErrorOutOfDeviceMemory);
+	}
+
+	descriptorBuffer.WriteBuffer(SetOffsets[0], bufferSetLayout, 0, 0, vk::DescriptorType::eUniformBuffer, uniformBuffer.address, sizeof(uint32_t));
+	descriptorBuffer.WriteBuffer(SetOffsets[0], bufferSetLayout, 1, 0, vk::DescriptorType::eStorageBuffer, resultBuffer.address, sizeof(uint32_t));
+	descriptorBuffer.WriteImage(SetOffsets[1], imageSetLayout, 0, 0, vk::DescriptorType::eSampledImage, VK_NULL_HANDLE, static_cast<VkImageView>(image), vk::ImageLayout::eShaderReadOnlyOptimal);
+	descriptorBuffer.WriteImage(SetOffsets[1], imageSetLayout, 1, 0, vk::DescriptorType::eSampler, sampler, VK_NULL_HANDLE, vk::ImageLayout::eUndefined);
+
+	CommandPool * pCommandPool = pCommandQueue->CreateCommandPool();
+
+	if (pCommandPool == nullptr)		return Fail("Command pool creation", Result::eErrorInitializationFailed);
+
+	CommandBuffer * pCommandBuffer = pCommandPool->AllocatePrimaryCommandBuffer();
+
+	if (pCommandBuffer == nullptr)		return Fail("Command buffer allocation", Result::eErrorInitializationFailed);
+
+	pCommandBuffer->BeginRecord(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+	const vk::ImageSubresourceRange ColorRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+
+	vk::ImageMemoryBarrier ClearBarrier(vk::AccessFlags(), vk::AccessFlagBits::eTransferWrite, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+									   VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, vk::Image(static_cast<VkImage>(image)), ColorRange);
+
+	pCommandBuffer->CmdImageMemoryBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), ClearBarrier);
+
+	VkClearColorValue ClearColor = {};
+
+	ClearColor.uint32[0] = TexelValue;
+
+	vk::ImageSubresourceRange ClearRange = ColorRange;
+
+	pCommandBuffer->CmdClearColorImage(image, vk::ImageLayout::eTransferDstOptimal, ClearColor, ClearRange);
+
+	vk::ImageMemoryBarrier ReadBarrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+									  VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, vk::Image(static_cast<VkImage>(image)), ColorRange);
+
+	pCommandBuffer->CmdImageMemoryBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(), ReadBarrier);
+
+	pCommandBuffer->CmdBindPipeline(&computePipeline);
+
+	descriptorBuffer.CmdBind(pCommandBuffer);
+
+	descriptorBuffer.CmdSetOffsets(pCommandBuffer, vk::PipelineBindPoint::eCompute, pipelineLayout, 0, SetOffsets);
+
+	pCommandBuffer->CmdDispatch(1);
+
+	VkBufferMemoryBarrier					ResultBarrier = {};
+	ResultBarrier.sType						= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	ResultBarrier.pNext						= nullptr;
+	ResultBarrier.srcAccessMask				= VK_ACCESS_SHADER_WRITE_BIT;
+	ResultBarrier.dstAccessMask				= VK_ACCESS_HOST_READ_BIT;
+	ResultBarrier.srcQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	ResultBarrier.dstQueueFamilyIndex		= VK_QUEUE_FAMILY_IGNORED;
+	ResultBarrier.buffer					= resultBuffer.hBuffer;
+	ResultBarrier.offset					= 0;
+	ResultBarrier.size						= VK_WHOLE_SIZE;
+
+	pCommandBuffer->CmdPipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eHost, vk::DependencyFlags(), ResultBarrier, nullptr);
+
+	eResult = pCommandBuffer->EndRecord();
+
+	if (eResult != Result::eSuccess)		return Fail("Command recording", eResult);
+
+	Fence fence(hDevice);
+
+	eResult = pCommandBuffer->Submit(fence);
+
+	if (eResult == Result::eSuccess)		eResult = fence.Wait();
+
+	//	Resources go out of scope below, nothing may be in flight.
+	pLogicalDevice->WaitIdle();
+
+	if (eResult != Result::eSuccess)		return Fail("Submission", eResult);
+
+	const uint32_t result = *resultBuffer.pMappedData;
+
+	if (result != UniformValue + TexelValue)
+	{
+		std::printf("DescriptorBufferTest: expected %u, the shader wrote %u.\n", UniformValue + TexelValue, result);
+
+		return ExitFailure;
+	}
+
+	std::printf("DescriptorBufferTest: passed (set offsets %llu, %llu).\n", static_cast<unsigned long long>(SetOffsets[0]), static_cast<unsigned long long>(SetOffsets[1]));
+
+	return ExitSuccess;
+}
+
+
+/**
+ *	@brief	Return the names out of pNames that are listed in Available.
+ */
+static std::vector<const char*> FilterAvailable(const std::vector<VkExtensionProperties> & Available, std::initializer_list<const char*> pNames)
+{
+	std::vector<const char*> pAvailableNames;
+
+	for (const char * pName : pNames)
+	{
+		for (auto & Extension : Available)
+		{
+			if (std::strcmp(Extension.extensionName, pName) == 0)
+			{
+				pAvailableNames.push_back(pName);
+
+				break;
+			}
+		}
+	}
+
+	return pAvailableNames;
+}
+
+#endif
+
+/*************************************************************************
+*******************************    Main    *******************************
+*************************************************************************/
+
+/**
+ *	@brief	Usage: DescriptorBufferTest [path of DescriptorBuffer.comp.spv], runs on any driver with VK_EXT_descriptor_buffer
+ *			(e.g. lavapipe via VK_ICD_FILENAMES or VK_DRIVER_FILES).
+ */
+int main(int argc, char ** argv)
+{
+#ifndef VK_EXT_descriptor_buffer
+	(void)argc;		(void)argv;
+
+	std::printf("DescriptorBufferTest: skipped, the Vulkan headers lack VK_EXT_descriptor_buffer.\n");
+
+	return ExitSkipped;
+#else
+	const char * pShaderPath = (argc > 1) ? argv[1] : "DescriptorBuffer.comp.spv";
+
+	//	Instance targets Vulkan 1.0, the dependencies of VK_EXT_descriptor_buffer are enabled as extensions.
+	std::vector<const char*> pInstanceExtensions = FilterAvailable(Instance::GetAvailableExtensions(), { "VK_KHR_get_physical_device_properties2", "VK_KHR_device_group_creation" });
+
+	Instance instance;
+
+	Result eResult = instance.Create(pInstanceExtensions);
+
+	if (eResult != Result::eSuccess)		return Fail("Instance creation", eResult);
+
+	auto pfnGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(instance.Handle(), "vkGetPhysicalDeviceFeatures2KHR");
+
+	PhysicalDevice * pPhysicalDevice = nullptr;
+
+	for (auto pCandidate : instance.GetPhysicalDevices())
+	{
+		if (!pfnGetPhysicalDeviceFeatures2)															break;
+		if (!pCandidate->IsExtensionAvailable(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))				continue;
+		if (!pCandidate->IsExtensionAvailable(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))			continue;
+
+		VkPhysicalDeviceBufferDeviceAddressFeaturesKHR		SupportedAddressFeatures = {};
+		SupportedAddressFeatures.sType						= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+
+		VkPhysicalDeviceDescriptorBufferFeaturesEXT			SupportedDescriptorBufferFeatures = {};
+		SupportedDescriptorBufferFeatures.sType				= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+		SupportedDescriptorBufferFeatures.pNext				= &SupportedAddressFeatures;
+
+		VkPhysicalDeviceFeatures2KHR						SupportedFeatures = {};
+		SupportedFeatures.sType								= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		SupportedFeatures.pNext								= &SupportedDescriptorBufferFeatures;
+
+		pfnGetPhysicalDeviceFeatures2(pCandidate->Handle(), &SupportedFeatures);
+
+		if (SupportedDescriptorBufferFeatures.descriptorBuffer && SupportedAddressFeatures.bufferDeviceAddress)
+		{
+			pPhysicalDevice = pCandidate;
+
+			break;
+		}
+	}
+
+	if (pPhysicalDevice == nullptr)
+	{
+		std::printf("DescriptorBufferTest: skipped, no device supports VK_EXT_descriptor_buffer.\n");
+
+		return ExitSkipped;
+	}
+
+	std::printf("DescriptorBufferTest: running on %s.\n", pPhysicalDevice->GetProperties().deviceName);
+
+	LogicalDevice * pLogicalDevice = pPhysicalDevice->CreateLogicalDevice();
+
+	CommandQueue * pCommandQueue = pLogicalDevice->PreInstallQueue(pPhysicalDevice->GetComputeQueueFamilyIndex());
+
+	for (const char * pExtensionName : { VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+										 "VK_KHR_device_group", "VK_KHR_synchronization2", "VK_KHR_maintenance3", "VK_EXT_descriptor_indexing" })
+	{
+		pLogicalDevice->EnableExtension(pExtensionName);
+	}
+
+	VkPhysicalDeviceBufferDeviceAddressFeaturesKHR		AddressFeatures = {};
+	AddressFeatures.sType								= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+	AddressFeatures.pNext								= nullptr;
+	AddressFeatures.bufferDeviceAddress					= VK_TRUE;
+
+	VkPhysicalDeviceDescriptorBufferFeaturesEXT			DescriptorBufferFeatures = {};
+	DescriptorBufferFeatures.sType						= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+	DescriptorBufferFeatures.pNext						= &AddressFeatures;
+	DescriptorBufferFeatures.descriptorBuffer			= VK_TRUE;
+
+	eResult = (pCommandQueue != nullptr) ? pLogicalDevice->StartUp(nullptr, &DescriptorBufferFeatures) : Result::eErrorInitializationFailed;
+
+	const int exitCode = (eResult == Result::eSuccess) ? RunCheck(pLogicalDevice, pCommandQueue, pShaderPath) : Fail("Device start up", eResult);
+
+	pPhysicalDevice->DestroyLogicalDevice(pLogicalDevice);
+
+	return exitCode;
+#endif
+}
\ No newline at end of file